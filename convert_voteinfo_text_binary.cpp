@@ -0,0 +1,630 @@
+//  convert_voteinfo_text_binary.cpp
+//
+//  This software utility converts voteinfo
+//  numbers between the text version that is read
+//  and written by the votefair_ranking.cpp and
+//  rcipe_stv.cpp code, and the compact binary
+//  voteinfo version that those programs also can
+//  read and write.
+//
+//  If the input is text, the output is binary.
+//  If the input is binary, the output is text.
+//  The text input can contain the same alias
+//  words (such as "case" and "bal") that the
+//  votefair_ranking.cpp code accepts.
+//
+//
+// -----------------------------------------------
+//
+//  COPYRIGHT & LICENSE
+//
+//  This file is part of the VoteFairRanking
+//  software, which is (c) Copyright 1991 through
+//  2019 by Richard Fobes at www.VoteFair.org.
+//  You can redistribute and/or modify this
+//  software under the MIT software license terms
+//  that appear in the source-code file
+//  votefair_ranking.cpp.  Also a copy of the
+//  license is included in the LICENSE file.
+//
+//  Conversion of this code into another
+//  programming language is also covered by the
+//  above license terms.
+//
+//
+// -----------------------------------------------
+//
+//  VERSION
+//
+//  Version 1.0 - Handles version 1 of the binary
+//  voteinfo format.
+//
+//
+// -----------------------------------------------
+//
+//  USAGE
+//
+//  The following sample code compiles and
+//  executes this software under a typical
+//  Windows environment with the g++ compiler and
+//  the mingw32 library already installed.
+//
+//      g++ convert_voteinfo_text_binary.cpp -o convert_voteinfo_text_binary
+//
+//      .\convert_voteinfo_text_binary < input_votefair_ranking_case_123.txt > input_votefair_ranking_case_123.vfvi
+//
+//      .\convert_voteinfo_text_binary < output_votefair_ranking_case_123.vfvi > output_votefair_ranking_case_123.txt
+//
+//  To request that votefair_ranking or rcipe_stv
+//  write its results in binary, include the
+//  voteinfo code -79 (or the alias word
+//  "request-binary-output") in the input.
+//
+//
+// -----------------------------------------------
+//
+//  BINARY VOTEINFO FORMAT
+//
+//  A binary file begins with the four characters
+//  "VFVI", then one byte for the format version
+//  number (currently 1), one byte for the
+//  content type (1 for ballot input, 2 for
+//  calculated results), and two reserved bytes
+//  that are zero.
+//
+//  Next are four unsigned numbers that contain
+//  the case number, the number of questions, the
+//  largest number of choices in any question,
+//  and the count of voteinfo numbers that
+//  follow.  Then each voteinfo number is stored,
+//  in the same sequence as in the text version.
+//
+//  Every number is stored in a variable-length
+//  form that uses seven bits per byte, with the
+//  lowest bits first, and with the highest bit
+//  set in every byte except the last byte.  The
+//  voteinfo numbers first have their sign moved
+//  into the lowest bit ("zigzag" encoding) so
+//  that small negative codes also fit in one
+//  byte.  Calculated results can contain 64-bit
+//  numbers, such as large pairwise tallies, so a
+//  number can use up to ten bytes.
+//
+//
+// -----------------------------------------------
+
+
+// -----------------------------------------------
+//  Specify libraries needed.
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#if defined( _WIN32 )
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+
+// -----------------------------------------------
+//  Declare constants, specifically the true and
+//  false values.
+
+const int global_true = 1 ;
+const int global_false = 0 ;
+
+
+// -----------------------------------------------
+//  Declare the voteinfo codes that are used to
+//  get the header counts, and to arrange the
+//  text output into lines.
+
+const int global_voteinfo_code_for_case_number = -3 ;
+const int global_voteinfo_code_for_question_number = -4 ;
+const int global_voteinfo_code_for_number_of_choices = -6 ;
+const int global_voteinfo_code_for_start_of_ballot = -9 ;
+const int global_voteinfo_code_for_end_of_ballot = -10 ;
+const int global_voteinfo_code_for_tie = -14 ;
+
+
+// -----------------------------------------------
+//  Declare the binary format constants.
+
+const int global_binary_voteinfo_format_version = 1 ;
+const int global_binary_content_type_voteinfo_input = 1 ;
+const int global_binary_content_type_result_codes = 2 ;
+
+
+// -----------------------------------------------
+//  Declare the input text, the list of voteinfo
+//  numbers, and the alias words.
+
+std::vector< char > global_input_text ;
+long global_input_position ;
+
+std::vector< long long > global_list_of_voteinfo_numbers ;
+
+std::map< std::string , int > global_voteinfo_code_for_alias_word ;
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  define_alias_words
+//
+//  Defines the alias words that can be used
+//  instead of negative voteinfo codes.  This list
+//  must match the list in votefair_ranking.cpp.
+
+void define_alias_words( )
+{
+    global_voteinfo_code_for_alias_word[ "startallcases" ] = -1 ;
+    global_voteinfo_code_for_alias_word[ "endallcases" ] = -2 ;
+    global_voteinfo_code_for_alias_word[ "case" ] = -3 ;
+    global_voteinfo_code_for_alias_word[ "q" ] = -4 ;
+    global_voteinfo_code_for_alias_word[ "votes" ] = -5 ;
+    global_voteinfo_code_for_alias_word[ "choices" ] = -6 ;
+    global_voteinfo_code_for_alias_word[ "startcase" ] = -7 ;
+    global_voteinfo_code_for_alias_word[ "endcase" ] = -8 ;
+    global_voteinfo_code_for_alias_word[ "bal" ] = -9 ;
+    global_voteinfo_code_for_alias_word[ "b" ] = -10 ;
+    global_voteinfo_code_for_alias_word[ "x" ] = -11 ;
+    global_voteinfo_code_for_alias_word[ "pref" ] = -12 ;
+    global_voteinfo_code_for_alias_word[ "ch" ] = -13 ;
+    global_voteinfo_code_for_alias_word[ "tie" ] = -14 ;
+    global_voteinfo_code_for_alias_word[ "popularity-sequence" ] = -15 ;
+    global_voteinfo_code_for_alias_word[ "end-pop-seq" ] = -16 ;
+    global_voteinfo_code_for_alias_word[ "popularity-levels" ] = -17 ;
+    global_voteinfo_code_for_alias_word[ "end-pop-levels" ] = -18 ;
+    global_voteinfo_code_for_alias_word[ "rep-seq" ] = -19 ;
+    global_voteinfo_code_for_alias_word[ "end-rep-seq" ] = -20 ;
+    global_voteinfo_code_for_alias_word[ "rep-levels" ] = -21 ;
+    global_voteinfo_code_for_alias_word[ "end-rep-levels" ] = -22 ;
+    global_voteinfo_code_for_alias_word[ "party-seq" ] = -23 ;
+    global_voteinfo_code_for_alias_word[ "end-party-seq" ] = -24 ;
+    global_voteinfo_code_for_alias_word[ "party-levels" ] = -25 ;
+    global_voteinfo_code_for_alias_word[ "end-party-levels" ] = -26 ;
+    global_voteinfo_code_for_alias_word[ "level" ] = -27 ;
+    global_voteinfo_code_for_alias_word[ "next-level" ] = -28 ;
+    global_voteinfo_code_for_alias_word[ "end-seq-early" ] = -29 ;
+    global_voteinfo_code_for_alias_word[ "tallies" ] = -30 ;
+    global_voteinfo_code_for_alias_word[ "end-tallies" ] = -31 ;
+    global_voteinfo_code_for_alias_word[ "ch1" ] = -32 ;
+    global_voteinfo_code_for_alias_word[ "ch2" ] = -33 ;
+    global_voteinfo_code_for_alias_word[ "1over2" ] = -34 ;
+    global_voteinfo_code_for_alias_word[ "2over1" ] = -35 ;
+    global_voteinfo_code_for_alias_word[ "plurality" ] = -36 ;
+    global_voteinfo_code_for_alias_word[ "end-plurality" ] = -37 ;
+    global_voteinfo_code_for_alias_word[ "plur" ] = -38 ;
+    global_voteinfo_code_for_alias_word[ "case-skipped" ] = -39 ;
+    global_voteinfo_code_for_alias_word[ "question-skipped" ] = -40 ;
+    global_voteinfo_code_for_alias_word[ "request-rep" ] = -41 ;
+    global_voteinfo_code_for_alias_word[ "request-no-rep" ] = -42 ;
+    global_voteinfo_code_for_alias_word[ "request-party" ] = -43 ;
+    global_voteinfo_code_for_alias_word[ "request-no-party" ] = -44 ;
+    global_voteinfo_code_for_alias_word[ "request-plurality-only" ] = -45 ;
+    global_voteinfo_code_for_alias_word[ "request-pairwise-counts" ] = -46 ;
+    global_voteinfo_code_for_alias_word[ "request-no-pairwise-counts" ] = -47 ;
+    global_voteinfo_code_for_alias_word[ "number-rep-levels-to-compute" ] = -48 ;
+    global_voteinfo_code_for_alias_word[ "request-text-output" ] = -49 ;
+    global_voteinfo_code_for_alias_word[ "request-instant-runoff-voting" ] = -50 ;
+    global_voteinfo_code_for_alias_word[ "request-instant-pairwise-elimination" ] = -51 ;
+    global_voteinfo_code_for_alias_word[ "request-rcipe-voting" ] = -52 ;
+    global_voteinfo_code_for_alias_word[ "winner-instant-runoff-voting" ] = -53 ;
+    global_voteinfo_code_for_alias_word[ "winner-instant-pairwise-elimination" ] = -54 ;
+    global_voteinfo_code_for_alias_word[ "winner-rcipe-voting" ] = -55 ;
+    global_voteinfo_code_for_alias_word[ "request-star-voting" ] = -56 ;
+    global_voteinfo_code_for_alias_word[ "winner-star-voting" ] = -57 ;
+    global_voteinfo_code_for_alias_word[ "request-pairwise-loser-elimination" ] = -58 ;
+    global_voteinfo_code_for_alias_word[ "winner-pairwise-loser-elimination" ] = -59 ;
+    global_voteinfo_code_for_alias_word[ "winner-irv-bottom-two-runoff" ] = -60 ;
+    global_voteinfo_code_for_alias_word[ "winner-borda-count" ] = -61 ;
+    global_voteinfo_code_for_alias_word[ "flag-as-interesting" ] = -62 ;
+    global_voteinfo_code_for_alias_word[ "winner-approval-voting" ] = -63 ;
+    global_voteinfo_code_for_alias_word[ "winner-condorcet" ] = -64 ;
+    global_voteinfo_code_for_alias_word[ "request-logging-off" ] = -65 ;
+    global_voteinfo_code_for_alias_word[ "winner-pairwise-support-count" ] = -66 ;
+    global_voteinfo_code_for_alias_word[ "number-of-equivalent-seats" ] = -67 ;
+    global_voteinfo_code_for_alias_word[ "request-quota-droop-not-hare" ] = -68 ;
+    global_voteinfo_code_for_alias_word[ "winner-next-seat" ] = -69 ;
+    global_voteinfo_code_for_alias_word[ "begin-tied-for-next-seat" ] = -70 ;
+    global_voteinfo_code_for_alias_word[ "end-tied-for-next-seat" ] = -71 ;
+    global_voteinfo_code_for_alias_word[ "counting-cycle-number" ] = -72 ;
+    global_voteinfo_code_for_alias_word[ "pairwise-losing-candidate" ] = -73 ;
+    global_voteinfo_code_for_alias_word[ "eliminated-candidate" ] = -74 ;
+    global_voteinfo_code_for_alias_word[ "quota-count-this-cycle" ] = -75 ;
+    global_voteinfo_code_for_alias_word[ "candidate-and-transfer-count" ] = -76 ;
+    global_voteinfo_code_for_alias_word[ "candidate-to-ignore" ] = -77 ;
+    global_voteinfo_code_for_alias_word[ "request-binary-output" ] = -79 ;
+    global_voteinfo_code_for_alias_word[ "number-of-tally-threads" ] = -80 ;
+    global_voteinfo_code_for_alias_word[ "exact-ranking-memory-limit" ] = -81 ;
+    global_voteinfo_code_for_alias_word[ "exact-ranking-time-limit" ] = -82 ;
+    global_voteinfo_code_for_alias_word[ "pop-proven-optimal" ] = -83 ;
+    global_voteinfo_code_for_alias_word[ "request-batch-cases" ] = -84 ;
+    global_voteinfo_code_for_alias_word[ "number-of-question-threads" ] = -85 ;
+    global_voteinfo_code_for_alias_word[ "invalid-input-word" ] = -200 ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  read_all_input
+//
+//  Reads all of standard input into memory, in
+//  large blocks.
+
+void read_all_input( )
+{
+    long count_of_characters_read ;
+    long input_length ;
+
+#if defined( _WIN32 )
+    _setmode( _fileno( stdin ) , _O_BINARY ) ;
+#endif
+
+    input_length = 0 ;
+    global_input_text.resize( 1048576 ) ;
+    while ( 1 )
+    {
+        if ( input_length == (long) global_input_text.size( ) )
+        {
+            global_input_text.resize( global_input_text.size( ) * 2 ) ;
+        }
+        count_of_characters_read = (long) fread( &global_input_text[ input_length ] , 1 , global_input_text.size( ) - input_length , stdin ) ;
+        if ( count_of_characters_read <= 0 )
+        {
+            break ;
+        }
+        input_length += count_of_characters_read ;
+    }
+    global_input_text.resize( input_length ) ;
+    global_input_position = 0 ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  convert_text_to_voteinfo_numbers
+//
+//  Converts the text input into voteinfo
+//  numbers.  The words are separated the same way
+//  votefair_ranking.cpp separates them: by
+//  spaces, commas, periods, and line breaks, with
+//  white space at the end of each line ignored.
+//  Each word is an alias word or is converted
+//  using the "atoi" rules.
+
+void convert_text_to_voteinfo_numbers( )
+{
+    long line_start ;
+    long line_end ;
+    long word_start ;
+    long word_end ;
+    long input_length ;
+    std::string input_text_word ;
+
+    input_length = (long) global_input_text.size( ) ;
+    line_start = 0 ;
+    while ( line_start < input_length )
+    {
+
+
+// -----------------------------------------------
+//  Find the end of the line, ignore white space
+//  at the end of the line, and stop at a null
+//  character.
+
+        line_end = line_start ;
+        while ( ( line_end < input_length ) && ( global_input_text[ line_end ] != '\n' ) )
+        {
+            line_end ++ ;
+        }
+        long next_line_start = line_end + 1 ;
+        while ( ( line_end > line_start ) && ( strchr( " \t\r" , global_input_text[ line_end - 1 ] ) != NULL ) )
+        {
+            line_end -- ;
+        }
+        for ( long pointer = line_start ; pointer < line_end ; pointer ++ )
+        {
+            if ( global_input_text[ pointer ] == '\0' )
+            {
+                line_end = pointer ;
+                break ;
+            }
+        }
+
+
+// -----------------------------------------------
+//  Convert each word in the line.
+
+        word_start = line_start ;
+        while ( word_start < line_end )
+        {
+            if ( ( global_input_text[ word_start ] == ' ' ) || ( global_input_text[ word_start ] == ',' ) || ( global_input_text[ word_start ] == '.' ) )
+            {
+                word_start ++ ;
+                continue ;
+            }
+            word_end = word_start ;
+            while ( ( word_end < line_end ) && ( global_input_text[ word_end ] != ' ' ) && ( global_input_text[ word_end ] != ',' ) && ( global_input_text[ word_end ] != '.' ) )
+            {
+                word_end ++ ;
+            }
+            input_text_word.assign( &global_input_text[ word_start ] , word_end - word_start ) ;
+            if ( global_voteinfo_code_for_alias_word.count( input_text_word ) > 0 )
+            {
+                global_list_of_voteinfo_numbers.push_back( global_voteinfo_code_for_alias_word[ input_text_word ] ) ;
+            } else
+            {
+                global_list_of_voteinfo_numbers.push_back( atoll( input_text_word.c_str( ) ) ) ;
+            }
+            word_start = word_end ;
+        }
+        line_start = next_line_start ;
+    }
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  put_binary_unsigned_number
+//
+//  Writes one variable-length unsigned number to
+//  the standard output.
+
+void put_binary_unsigned_number( unsigned long long number_value )
+{
+    while ( number_value >= 128 )
+    {
+        std::cout.put( (char) ( ( number_value & 127 ) | 128 ) ) ;
+        number_value = number_value >> 7 ;
+    }
+    std::cout.put( (char) number_value ) ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  write_binary_voteinfo_numbers
+//
+//  Writes the voteinfo numbers in the binary
+//  format, with header counts that are taken
+//  from the case-number, question-number, and
+//  number-of-choices codes.
+
+void write_binary_voteinfo_numbers( )
+{
+    int case_number ;
+    int question_count ;
+    int choice_count ;
+    long long voteinfo_number ;
+    std::size_t pointer ;
+
+
+// -----------------------------------------------
+//  Get the header counts.
+
+    case_number = 0 ;
+    question_count = 0 ;
+    choice_count = 0 ;
+    for ( pointer = 0 ; pointer + 1 < global_list_of_voteinfo_numbers.size( ) ; pointer ++ )
+    {
+        voteinfo_number = global_list_of_voteinfo_numbers[ pointer + 1 ] ;
+        if ( ( global_list_of_voteinfo_numbers[ pointer ] == global_voteinfo_code_for_case_number ) && ( case_number == 0 ) && ( voteinfo_number > 0 ) )
+        {
+            case_number = voteinfo_number ;
+        } else if ( ( global_list_of_voteinfo_numbers[ pointer ] == global_voteinfo_code_for_question_number ) && ( voteinfo_number > question_count ) )
+        {
+            question_count = voteinfo_number ;
+        } else if ( ( global_list_of_voteinfo_numbers[ pointer ] == global_voteinfo_code_for_number_of_choices ) && ( voteinfo_number > choice_count ) )
+        {
+            choice_count = voteinfo_number ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  Write the header, then the numbers.
+
+#if defined( _WIN32 )
+    _setmode( _fileno( stdout ) , _O_BINARY ) ;
+#endif
+    std::cout.write( "VFVI" , 4 ) ;
+    std::cout.put( (char) global_binary_voteinfo_format_version ) ;
+    std::cout.put( (char) global_binary_content_type_voteinfo_input ) ;
+    std::cout.put( (char) 0 ) ;
+    std::cout.put( (char) 0 ) ;
+    put_binary_unsigned_number( (unsigned int) case_number ) ;
+    put_binary_unsigned_number( (unsigned int) question_count ) ;
+    put_binary_unsigned_number( (unsigned int) choice_count ) ;
+    put_binary_unsigned_number( (unsigned int) global_list_of_voteinfo_numbers.size( ) ) ;
+    for ( pointer = 0 ; pointer < global_list_of_voteinfo_numbers.size( ) ; pointer ++ )
+    {
+        voteinfo_number = global_list_of_voteinfo_numbers[ pointer ] ;
+        put_binary_unsigned_number( ( (unsigned long long) voteinfo_number << 1 ) ^ (unsigned long long) ( voteinfo_number >> 63 ) ) ;
+    }
+    std::cout.flush( ) ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  get_next_binary_unsigned_number
+//
+//  Gets the next variable-length unsigned number
+//  from the binary input.  Exits with an error
+//  message if the input ends within the number.
+
+unsigned long long get_next_binary_unsigned_number( )
+{
+    unsigned long long number_value ;
+    int next_byte ;
+    int bit_shift ;
+
+    number_value = 0 ;
+    for ( bit_shift = 0 ; bit_shift < 70 ; bit_shift += 7 )
+    {
+        if ( global_input_position >= (long) global_input_text.size( ) )
+        {
+            break ;
+        }
+        next_byte = (unsigned char) global_input_text[ global_input_position ] ;
+        global_input_position ++ ;
+        number_value |= ( (unsigned long long) ( next_byte & 127 ) ) << bit_shift ;
+        if ( ( next_byte & 128 ) == 0 )
+        {
+            return number_value ;
+        }
+    }
+    std::cerr << "Error: Binary input ends early or contains an invalid number." << std::endl ;
+    exit( EXIT_FAILURE ) ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  convert_binary_to_text
+//
+//  Converts binary input into text.  Ballot input
+//  is written with each ballot on its own line.
+//  Calculated results are written with one
+//  number per line, the same way the programs
+//  write their results.
+
+void convert_binary_to_text( )
+{
+    int format_version ;
+    int content_type ;
+    int count_of_numbers ;
+    int input_number_count ;
+    long long voteinfo_number ;
+    long long previous_voteinfo_number ;
+    unsigned long long encoded_number ;
+
+
+// -----------------------------------------------
+//  Check the version, then skip the reserved
+//  bytes and the header counts.
+
+    if ( global_input_text.size( ) < 8 )
+    {
+        std::cerr << "Error: Binary input is too short." << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+    format_version = (unsigned char) global_input_text[ 4 ] ;
+    content_type = (unsigned char) global_input_text[ 5 ] ;
+    if ( format_version != global_binary_voteinfo_format_version )
+    {
+        std::cerr << "Error: Binary input has unsupported version " << format_version << "." << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+    global_input_position = 8 ;
+    get_next_binary_unsigned_number( ) ;
+    get_next_binary_unsigned_number( ) ;
+    get_next_binary_unsigned_number( ) ;
+    count_of_numbers = (int) get_next_binary_unsigned_number( ) ;
+
+
+// -----------------------------------------------
+//  Write each number.  For ballot input, start a
+//  new line at each negative code that is not
+//  part of a ballot's rankings, and that does not
+//  follow another negative code.
+
+    previous_voteinfo_number = 0 ;
+    for ( input_number_count = 0 ; input_number_count < count_of_numbers ; input_number_count ++ )
+    {
+        encoded_number = get_next_binary_unsigned_number( ) ;
+        voteinfo_number = (long long) ( encoded_number >> 1 ) ^ - (long long) ( encoded_number & 1 ) ;
+        if ( content_type == global_binary_content_type_result_codes )
+        {
+            std::cout << voteinfo_number << "\n" ;
+        } else
+        {
+            if ( input_number_count > 0 )
+            {
+                if ( ( voteinfo_number < 0 ) && ( previous_voteinfo_number >= 0 ) && ( voteinfo_number != global_voteinfo_code_for_tie ) && ( voteinfo_number != global_voteinfo_code_for_end_of_ballot ) )
+                {
+                    std::cout << "\n" ;
+                } else if ( ( voteinfo_number == global_voteinfo_code_for_start_of_ballot ) && ( previous_voteinfo_number != global_voteinfo_code_for_end_of_ballot ) )
+                {
+                    std::cout << "\n" ;
+                } else if ( previous_voteinfo_number == global_voteinfo_code_for_end_of_ballot )
+                {
+                    std::cout << "\n" ;
+                } else
+                {
+                    std::cout << " " ;
+                }
+            }
+            std::cout << voteinfo_number ;
+        }
+        previous_voteinfo_number = voteinfo_number ;
+    }
+    if ( ( content_type != global_binary_content_type_result_codes ) && ( count_of_numbers > 0 ) )
+    {
+        std::cout << "\n" ;
+    }
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  Execution starts here.
+
+int main( ) {
+
+
+// -----------------------------------------------
+//  Read the input.
+
+    define_alias_words( ) ;
+    read_all_input( ) ;
+
+
+// -----------------------------------------------
+//  If the input begins with the binary signature,
+//  convert it to text.  Otherwise convert the
+//  text to binary.
+
+    if ( ( global_input_text.size( ) >= 4 ) && ( memcmp( &global_input_text[ 0 ] , "VFVI" , 4 ) == 0 ) )
+    {
+        convert_binary_to_text( ) ;
+    } else
+    {
+        convert_text_to_voteinfo_numbers( ) ;
+        write_binary_voteinfo_numbers( ) ;
+    }
+
+
+// -----------------------------------------------
+//  End of "main" code.
+
+    return 0 ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//
+//  End of all code.
+//
+// -----------------------------------------------
+// -----------------------------------------------
+
+
+// -----------------------------------------------
+//
+//  AUTHOR
+//
+//  Richard Fobes, www.VoteFair.org
+//
+//
+// -----------------------------------------------
+//
+//  End of convert_voteinfo_text_binary.cpp
@@ -155,6 +155,23 @@
 //  "VoteFair-polls" code on GitHub (in the
 //  CPSolver repository).
 //
+//  The input file also can be in the compact
+//  binary voteinfo format, which is recognized
+//  automatically.  Voteinfo code -79 requests
+//  that the results be written in that binary
+//  format.  The convert_voteinfo_text_binary.cpp
+//  utility converts between the text and binary
+//  versions.
+//
+//  Voteinfo code -80 (alias word
+//  "number-of-tally-threads"), followed by a
+//  number from 1 to 64, requests that the ballot
+//  groups be counted by that many threads during
+//  each counting cycle.  The results are the same
+//  for any number of threads.  With some older
+//  compilers the "-pthread" option must be added
+//  to the g++ command.
+//
 //  The input file must contain integer codes that
 //  have the meanings specified in the constants
 //  that begin with "global_voteinfo_code_for_...".
@@ -270,6 +287,34 @@
 #include <string>
 #include <cstring>
 #include <cstdio>
+#include <vector>
+#include <thread>
+
+
+// -----------------------------------------------
+//  Specify the libraries needed to memory-map the
+//  input file.  These are only available on
+//  Unix-like systems, so other systems read the
+//  input file in large blocks instead.
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#define RCIPE_STV_USE_MEMORY_MAPPED_INPUT
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+// -----------------------------------------------
+//  On Windows, specify the libraries needed to
+//  switch standard input and output to binary
+//  mode, which is needed for the binary version
+//  of the voteinfo numbers.
+
+#if defined( _WIN32 )
+#include <io.h>
+#include <fcntl.h>
+#endif
 
 
 // -----------------------------------------------
@@ -291,11 +336,14 @@ int global_number_of_seats_to_fill ;
 int global_true_or_false_request_no_pairwise_loser_elimination ;
 int global_true_or_false_request_quota_droop ;
 int global_true_or_false_request_ignore_shared_rankings ;
+int global_true_or_false_request_binary_output ;
+int global_number_of_tally_threads ;
 
 
 //  Declare global variables.
 
 int global_input_line_number ;
+int global_input_error_count ;
 int global_current_voteinfo_number ;
 int global_next_voteinfo_number ;
 int global_previous_voteinfo_number ;
@@ -352,9 +400,8 @@ const int global_maximum_candidate_number = 100 ;
 int global_true_or_false_winner_candidate[ 101 ] ;
 int global_true_or_false_eliminated_candidate[ 101 ] ;
 int global_true_or_false_available_candidate[ 101 ] ;
-int global_true_or_false_is_top_ranked_candidate[ 101 ] ;
+int global_true_or_false_tracked_candidate[ 101 ] ;
 int global_true_or_false_pairwise_consider_candidate[ 101 ] ;
-int global_ballot_preference_for_candidate[ 101 ] ;
 int global_vote_transfer_count_for_candidate[ 101 ] ;
 int global_win_count_for_candidate[ 101 ] ;
 int global_loss_count_for_candidate[ 101 ] ;
@@ -367,10 +414,71 @@ int global_list_of_candidates_tied[ 101 ] ;
 
 //  Declare the input-related list.
 //  Allow room for extra codes at the end.
+//
+//  The voteinfo numbers are stored in chunks of
+//  65536 numbers, and a new chunk is added
+//  whenever more space is needed.  This avoids a
+//  fixed limit on the number of ballots, and
+//  adding a chunk never moves the numbers that
+//  are already stored.  The numbers are accessed
+//  through the functions get_vote_info_number
+//  and put_vote_info_number.
+
+const int global_vote_info_chunk_size_bits = 16 ;
+const int global_vote_info_chunk_size = 65536 ;
+
+std::vector< std::vector< int > > global_vote_info_chunks ;
+
+
+//  Declare the variables that track the input
+//  text.  The input file is memory-mapped when
+//  possible, otherwise it is read in large blocks
+//  into a buffer that can grow to hold a long
+//  line.  The most recent line is identified by a
+//  pointer to its first character and its length,
+//  so the text is never copied.
+
+const int global_input_block_size = 1048576 ;
+
+const char * global_input_text_pointer ;
+long global_input_text_length ;
+long global_input_text_position ;
+int global_true_or_false_input_is_memory_mapped ;
+int global_true_or_false_input_reached_end_of_file ;
+std::vector< char > global_input_block_buffer ;
+const char * global_input_line_start ;
+long global_input_line_length ;
+
+
+//  Declare the constants that identify the binary
+//  version of the voteinfo numbers.  A binary
+//  file begins with the four characters "VFVI",
+//  then one byte for the format version number,
+//  one byte for the content type (ballot input or
+//  calculated results), and two reserved bytes
+//  that are zero.  Next are four unsigned numbers
+//  that contain the case number, the number of
+//  questions, the largest number of choices in
+//  any question, and the count of voteinfo
+//  numbers that follow.  Then each voteinfo
+//  number is stored, in the same sequence as in
+//  the text version.  Ballot records therefore
+//  keep their repeat counts.
+//
+//  Every number is stored in a variable-length
+//  form that uses seven bits per byte, with the
+//  lowest bits first, and with the highest bit
+//  set in every byte except the last byte.  The
+//  voteinfo numbers first have their sign moved
+//  into the lowest bit ("zigzag" encoding) so
+//  that small negative codes also fit in one
+//  byte.
 
-const int global_maximum_vote_info_list_length = 200000 ;
+const int global_binary_voteinfo_format_version = 1 ;
+const int global_binary_content_type_voteinfo_input = 1 ;
+const int global_binary_content_type_result_codes = 2 ;
 
-int global_vote_info_list[ 200005 ] ;
+int global_true_or_false_binary_input_is_truncated ;
 
 
 //  Declare the output-related list.
@@ -385,31 +493,141 @@ int global_output_results[ 2005 ] ;
 
 const int global_maximum_candidate_pairs = 20000 ;
 
-int global_first_candidate_number_in_pair[ 2001 ] ;
-int global_second_candidate_number_in_pair[ 2001 ] ;
-int global_tally_first_over_second_in_pair[ 2001 ] ;
-int global_tally_second_over_first_in_pair[ 2001 ] ;
-int global_tally_first_equal_second_in_pair[ 2001 ] ;
+int global_first_candidate_number_in_pair[ 20001 ] ;
+int global_second_candidate_number_in_pair[ 20001 ] ;
+int global_tally_first_over_second_in_pair[ 20001 ] ;
+int global_tally_second_over_first_in_pair[ 20001 ] ;
+int global_tally_first_equal_second_in_pair[ 20001 ] ;
 
 
-//  Declare the lists that group identical ballots
-//  together for faster processing.
+//  Declare the pairwise counts that are kept
+//  between counting cycles.  The count at
+//  position ( first * ( N + 1 ) ) + second, where
+//  N is the number of candidates, is the number
+//  of remaining ballots that rank the first
+//  candidate above the second candidate.  The
+//  ballot count already included from each
+//  ballot group is saved, so that only changes
+//  need to be added.
+
+std::vector< int > global_pairwise_count_first_over_second ;
+std::vector< int > global_ballot_count_in_pairwise_counts_for_ballot_group ;
+int global_total_ballot_count_in_pairwise_counts ;
+int global_true_or_false_pairwise_counts_exist ;
+int global_count_of_pairwise_counted_candidates ;
+int global_list_of_pairwise_counted_candidates[ 101 ] ;
 
-const int global_maximum_number_of_ballot_groups = 20000 ;
 
-int global_ballot_count_remaining_for_ballot_group[ 20001 ] ;
-int global_top_ranked_candidate_for_ballot_group[ 20001 ] ;
+//  Declare the lists that group identical ballots
+//  together for faster processing.  These lists
+//  are lengthened as each ballot group is read.
+
+std::vector< int > global_ballot_count_remaining_for_ballot_group ;
+std::vector< int > global_top_ranked_candidate_for_ballot_group ;
+
+
+//  Declare the ballot-group table.  After all the
+//  ballots have been read, each group of identical
+//  ballots is compiled into one row that has a
+//  preference level for every candidate number,
+//  and the row's position zero is not used.  The
+//  rows are stored one after another in a single
+//  list, and the row for the current ballot group
+//  begins at global_pointer_to_ballot_group_row.
+//  The counting cycles use this table instead of
+//  re-reading the voteinfo numbers.
+
+std::vector< int > global_ballot_count_for_ballot_group ;
+std::vector< int > global_preference_level_in_ballot_group_table ;
+long global_pointer_to_ballot_group_row ;
+int global_length_of_ballot_group_row ;
+
+
+//  Declare the lists that track which remaining
+//  candidates are top-ranked in each ballot group.
+//  Each ballot group's row in the list
+//  global_candidate_in_ballot_group_order has the
+//  candidate numbers in preference order, and the
+//  top-ranked remaining candidates are at the
+//  preference level that begins at the position
+//  in global_top_position_for_ballot_group.  The
+//  list for each candidate number in
+//  global_ballot_groups_top_ranking_candidate
+//  identifies the ballot groups in which that
+//  candidate is top-ranked, so only those ballot
+//  groups are updated when that candidate is
+//  elected or eliminated.
+
+std::vector< int > global_candidate_in_ballot_group_order ;
+std::vector< int > global_top_position_for_ballot_group ;
+std::vector< int > global_top_preference_level_for_ballot_group ;
+std::vector< int > global_count_of_top_ranked_for_ballot_group ;
+std::vector< std::vector< int > > global_ballot_groups_top_ranking_candidate ;
 
 
 //  Declare the lists that combine the counting of
 //  ballots that have the same equivalent top-ranked
 //  candidates (during that counting cycle).
 
-const int global_maximum_number_of_pattern_numbers = 10000 ;
-
-int global_pattern_number_for_pattern_number_pointer[ 10001 ] ;
-int global_ballot_count_for_pattern_number_pointer[ 10001 ] ;
-int global_top_candidate_count_for_pattern_number_pointer[ 10001 ] ;
+//
+//  Each pattern identifies its shared top-ranked
+//  candidates as a set of bits, with one bit for
+//  each candidate number, stored in
+//  global_pattern_words_per_pattern words.  The
+//  pattern's candidate numbers are also listed,
+//  in candidate-number order, in the list
+//  global_candidates_for_patterns beginning at
+//  the position in
+//  global_start_of_candidates_for_pattern_number_pointer.
+//
+//  The patterns are found using a hash table.
+//  Each slot contains a pattern number pointer,
+//  or zero if the slot is empty.  The hash table
+//  doubles in size whenever it becomes half full,
+//  so there is no limit on the number of
+//  patterns.
+
+const int global_pattern_bits_per_word = 64 ;
+const int global_pattern_words_per_pattern = ( global_maximum_candidate_number / global_pattern_bits_per_word ) + 1 ;
+const int global_initial_pattern_hash_slot_count = 1024 ;
+
+std::vector< unsigned long long > global_bits_for_pattern_number_pointer ;
+std::vector< int > global_ballot_count_for_pattern_number_pointer ;
+std::vector< int > global_top_candidate_count_for_pattern_number_pointer ;
+std::vector< int > global_start_of_candidates_for_pattern_number_pointer ;
+std::vector< int > global_hash_slot_for_pattern_number_pointer ;
+std::vector< int > global_candidates_for_patterns ;
+std::vector< int > global_pattern_number_pointer_in_hash_slot ;
+
+
+//  Declare the lists that are used when the
+//  ballot groups are counted by more than one
+//  thread.  The ballot groups are split into
+//  shards, one shard per thread, and each shard
+//  has its own lists, so the threads never change
+//  the same numbers.  A ballot group that has
+//  just one top-ranked candidate is added to its
+//  shard's count for that candidate.  A ballot
+//  group that has more than one top-ranked
+//  candidate is added to its shard's list of
+//  shared ballot groups, which are later added
+//  to the top-ranking patterns in ballot-group
+//  order.  Each shard also has its own pairwise
+//  counts for the changes it adds, except the
+//  last shard, which adds its changes directly to
+//  the pairwise counts.  After all the threads
+//  finish, the shard results are combined in
+//  shard order, so the results are the same for
+//  any number of threads.
+
+const int global_maximum_number_of_tally_threads = 64 ;
+
+int global_ballot_count_for_single_top_candidate[ 101 ] ;
+int global_shard_ballot_count_for_single_top_candidate[ 64 ][ 101 ] ;
+std::vector< int > global_shard_list_of_shared_ballot_groups[ 64 ] ;
+std::vector< int > global_shard_pairwise_count_first_over_second[ 64 ] ;
+std::vector< int > global_list_of_changed_ballot_groups ;
+std::vector< int > global_ballot_count_change_for_changed_ballot_group ;
 
 
 //  Note:  Do NOT change these numbers!  They
@@ -505,6 +723,8 @@ const int global_voteinfo_code_for_quota_count_this_cycle = -75 ;
 const int global_voteinfo_code_for_candidate_and_transfer_count = -76 ;
 const int global_voteinfo_code_for_candidate_to_ignore = -77 ;
 const int global_voteinfo_code_for_request_ignore_shared_rankings = -78 ;
+const int global_voteinfo_code_for_request_binary_output = -79 ;
+const int global_voteinfo_code_for_number_of_tally_threads = -80 ;
 
 const int global_voteinfo_code_for_invalid_input_word = -200 ;
 
@@ -601,6 +821,92 @@ int convert_text_to_integer( char * supplied_text )
 }
 
 
+// -----------------------------------------------
+// -----------------------------------------------
+//  convert_text_span_to_integer
+//
+//  Converts the digits at the supplied location
+//  into an integer, without requiring the text to
+//  end with a null character.  The conversion
+//  follows the same rules as the "atoi" function:
+//  leading white space is skipped, an optional
+//  sign is allowed, conversion stops at the first
+//  non-digit character, and text that does not
+//  begin with a number converts to zero.
+
+int convert_text_span_to_integer( const char * supplied_text , long text_length )
+{
+    long pointer ;
+    long long accumulated_value ;
+    int sign_value ;
+    pointer = 0 ;
+    while ( ( pointer < text_length ) && ( ( supplied_text[ pointer ] == ' ' ) || ( ( supplied_text[ pointer ] >= '\t' ) && ( supplied_text[ pointer ] <= '\r' ) ) ) )
+    {
+        pointer ++ ;
+    }
+    sign_value = 1 ;
+    if ( ( pointer < text_length ) && ( ( supplied_text[ pointer ] == '-' ) || ( supplied_text[ pointer ] == '+' ) ) )
+    {
+        if ( supplied_text[ pointer ] == '-' )
+        {
+            sign_value = -1 ;
+        }
+        pointer ++ ;
+    }
+    accumulated_value = 0 ;
+    while ( ( pointer < text_length ) && ( supplied_text[ pointer ] >= '0' ) && ( supplied_text[ pointer ] <= '9' ) )
+    {
+        if ( accumulated_value < 100000000000LL )
+        {
+            accumulated_value = ( accumulated_value * 10 ) + ( supplied_text[ pointer ] - '0' ) ;
+        }
+        pointer ++ ;
+    }
+    return (int) ( sign_value * accumulated_value ) ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  get_vote_info_number
+//
+//  Gets the voteinfo number at the supplied
+//  position in the list of voteinfo numbers.
+//  Positions that have not been stored yet
+//  contain zero.
+
+int get_vote_info_number( int pointer )
+{
+    int chunk_number ;
+    chunk_number = pointer >> global_vote_info_chunk_size_bits ;
+    if ( ( pointer < 0 ) || ( chunk_number >= (int) global_vote_info_chunks.size( ) ) )
+    {
+        return 0 ;
+    }
+    return global_vote_info_chunks[ chunk_number ][ pointer & ( global_vote_info_chunk_size - 1 ) ] ;
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//  put_vote_info_number
+//
+//  Stores a voteinfo number at the supplied
+//  position in the list of voteinfo numbers,
+//  adding chunks as needed.
+
+void put_vote_info_number( int pointer , int vote_info_number )
+{
+    int chunk_number ;
+    chunk_number = pointer >> global_vote_info_chunk_size_bits ;
+    while ( chunk_number >= (int) global_vote_info_chunks.size( ) )
+    {
+        global_vote_info_chunks.push_back( std::vector< int >( global_vote_info_chunk_size , 0 ) ) ;
+    }
+    global_vote_info_chunks[ chunk_number ][ pointer & ( global_vote_info_chunk_size - 1 ) ] = vote_info_number ;
+}
+
+
 // -----------------------------------------------
 // -----------------------------------------------
 //    do_main_initialization
@@ -650,6 +956,9 @@ void do_main_initialization( )
     global_true_or_false_request_quota_droop = global_false ;
     global_true_or_false_request_no_pairwise_loser_elimination = global_false ;
     global_true_or_false_request_ignore_shared_rankings = global_false ;
+    global_true_or_false_request_binary_output = global_false ;
+    global_true_or_false_pairwise_counts_exist = global_false ;
+    global_number_of_tally_threads = 1 ;
 
 
 // -----------------------------------------------
@@ -665,10 +974,9 @@ void do_main_initialization( )
 // -----------------------------------------------
 //  Initialize lists to zeros.
 
-    for ( pointer = 0 ; pointer <= global_maximum_vote_info_list_length ; pointer ++ )
-    {
-        global_vote_info_list[ pointer ] = 0 ;
-    }
+    global_vote_info_chunks.clear( ) ;
+    global_ballot_count_remaining_for_ballot_group.assign( 1 , 0 ) ;
+    global_top_ranked_candidate_for_ballot_group.assign( 1 , 0 ) ;
     for ( pointer = 0 ; pointer <= global_maximum_output_results_length ; pointer ++ )
     {
         global_output_results[ pointer ] = 0 ;
@@ -713,23 +1021,11 @@ void save_ballot_info_number( int voteinfo_number )
     global_pointer_to_voteinfo_number ++ ;
 
 
-// -----------------------------------------------
-//  If the list has become too long, indicate that
-//  fatal error.
-
-    if ( global_pointer_to_voteinfo_number > global_maximum_vote_info_list_length )
-    {
-        if ( global_logging_info == global_true ) { log_out << "[error, too many vote-info numbers supplied, the available storage space must be increased]" ; } ;
-        std::cout << "Error: Too many vote-info numbers supplied, the available storage space must be increased." ;
-        exit( EXIT_FAILURE ) ;
-    }
-
-
 // -----------------------------------------------
 //  Store the supplied ballot-specific voteinfo
 //  number.
 
-    global_vote_info_list[ global_pointer_to_voteinfo_number ] = voteinfo_number ;
+    put_vote_info_number( global_pointer_to_voteinfo_number , voteinfo_number ) ;
 //    if ( global_logging_info == global_true ) { log_out << "[at " << global_pointer_to_voteinfo_number << " vicode " << voteinfo_number << "]" ; } ;
 
 
@@ -738,7 +1034,7 @@ void save_ballot_info_number( int voteinfo_number )
 //  position, in case this is the last voteinfo
 //  number put into the list.
 
-    global_vote_info_list[ global_pointer_to_voteinfo_number + 1 ] = global_voteinfo_code_for_end_of_all_vote_info ;
+    put_vote_info_number( global_pointer_to_voteinfo_number + 1 , global_voteinfo_code_for_end_of_all_vote_info ) ;
 
 
 // -----------------------------------------------
@@ -906,15 +1202,13 @@ void handle_one_voteinfo_number( )
         save_ballot_info_number( global_ballot_info_repeat_count ) ;
         global_count_of_candidates_marked = 0 ;
         global_total_count_of_ballot_groups ++ ;
+        global_ballot_count_remaining_for_ballot_group.push_back( 0 ) ;
+        global_top_ranked_candidate_for_ballot_group.push_back( 0 ) ;
         if ( global_logging_info == global_true ) { log_out << "[bc " << global_ballot_info_repeat_count << "]" ; } ;
         if ( global_ballot_info_repeat_count < 1 )
         {
             if ( global_logging_info == global_true ) { log_out << "[error, ballot count number is less than one (" << global_ballot_info_repeat_count << ")]" ; } ;
             global_possible_error_message = "Error: Ballot count number is less than one (" + convert_integer_to_text( global_ballot_info_repeat_count ) + ")." ;
-        } else if ( global_total_count_of_ballot_groups >= global_maximum_number_of_ballot_groups )
-        {
-            if ( global_logging_info == global_true ) { log_out << "[error, number of ballot groups (" << global_total_count_of_ballot_groups << ") exceeds available storage space]" ; } ;
-            global_possible_error_message = "Error: Number of ballot groups (" + convert_integer_to_text( global_total_count_of_ballot_groups ) + ") exceeds the available storage space." ;
         }
         return ;
     }
@@ -1026,6 +1320,26 @@ void handle_one_voteinfo_number( )
     }
 
 
+// -----------------------------------------------
+//  Get the number of threads to use when
+//  counting the ballot groups, then return.  The
+//  results do not depend on this number, so it
+//  is not written to the results info.
+
+    if ( global_previous_voteinfo_number == global_voteinfo_code_for_number_of_tally_threads )
+    {
+        if ( ( global_current_voteinfo_number < 1 ) || ( global_current_voteinfo_number > global_maximum_number_of_tally_threads ) )
+        {
+            if ( global_logging_info == global_true ) { log_out << "[error, number of tally threads (" << global_current_voteinfo_number << ") is not valid]" ; } ;
+            global_possible_error_message = "Error: Number of tally threads (" + convert_integer_to_text( global_current_voteinfo_number ) + ") is not between 1 and " + convert_integer_to_text( global_maximum_number_of_tally_threads ) + "." ;
+            return ;
+        }
+        global_number_of_tally_threads = global_current_voteinfo_number ;
+        if ( global_logging_info == global_true ) { log_out << "[tally threads " << global_number_of_tally_threads << "]" ; } ;
+        return ;
+    }
+
+
 // -----------------------------------------------
 //  If there is a request to ignore a candidate,
 //  specify that it is already eliminated.  This
@@ -1170,6 +1484,19 @@ void handle_one_voteinfo_number( )
     }
 
 
+// -----------------------------------------------
+//  If there is a request to write the results in
+//  the binary voteinfo format, save this request
+//  in a flag, then return.
+
+    if ( global_current_voteinfo_number == global_voteinfo_code_for_request_binary_output )
+    {
+        global_true_or_false_request_binary_output = global_true ;
+        if ( global_logging_info == global_true ) { log_out << "[request binary output]" ; } ;
+        return ;
+    }
+
+
 // -----------------------------------------------
 //  If the code for the end of all cases is
 //  encountered without yet encountering a case
@@ -1205,492 +1532,1680 @@ void handle_one_voteinfo_number( )
 
 // -----------------------------------------------
 // -----------------------------------------------
-//         read_data
+//     open_input_text
 //
-//  Reads numbers, including codes (which are
-//  negative numbers) from the standard input
-//  file.  These numbers supply ballot data and
-//  specify what to calculate and what results to
-//  include in the results.  The codes that
-//  specify ballot marks are saved in a list where
-//  they can be accessed repeatedly.
+//  Prepares to read the input text from standard
+//  input.  If standard input is a regular file,
+//  the whole file is memory-mapped so that the
+//  text can be scanned without being copied.
+//  Otherwise the text is read in large blocks.
 
-void read_data( )
+void open_input_text( )
 {
 
-    int candidate_number ;
-    int error_count ;
-
-    std::string input_line ;
-    std::string input_text_word ;
-
-
-// -----------------------------------------------
-//  Initialization.
-
-    error_count = 0 ;
-    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
-    {
-        global_tally_uses_of_candidate_number[ candidate_number ] = 0 ;
-    }
+    global_input_text_pointer = NULL ;
+    global_input_text_length = 0 ;
+    global_input_text_position = 0 ;
+    global_true_or_false_input_is_memory_mapped = global_false ;
+    global_true_or_false_input_reached_end_of_file = global_false ;
 
 
 // -----------------------------------------------
-//  Indicate the current status.
+//  On Windows, read standard input in binary mode
+//  so that binary voteinfo numbers are not
+//  altered.  Text is not affected because
+//  carriage-return characters at the end of each
+//  line are ignored.
 
-    if ( global_logging_info == global_true ) { log_out << "[about to start checking vote-info numbers]" << std::endl ; } ;
+#if defined( _WIN32 )
+    _setmode( _fileno( stdin ) , _O_BINARY ) ;
+#endif
 
 
 // -----------------------------------------------
-//  Begin loop to handle one line from the input
-//  file, which is "standard input" (which means
-//  it's the input file specified on the command
-//  line).
-//
-//  Although each code can be on a different line,
-//  or all the codes and tokens can be on a single
-//  line (if it is not too long), for clarity
-//  each ballot can be on a separate line.
+//  If possible, memory-map the input file.
 
-    for ( std::string input_line ; std::getline( std::cin , input_line ) ; )
+#ifdef RCIPE_STV_USE_MEMORY_MAPPED_INPUT
+    struct stat file_status ;
+    if ( ( fstat( fileno( stdin ) , &file_status ) == 0 ) && S_ISREG( file_status.st_mode ) && ( file_status.st_size > 0 ) )
     {
-        global_input_line_number ++ ;
-        std::size_t pointer_found = input_line.find_last_not_of( " \t\n\r" ) ;
-        if ( pointer_found != std::string::npos )
-        {
-            input_line.erase( pointer_found + 1 ) ;
-        } else
+        void * mapped_address = mmap( NULL , (size_t) file_status.st_size , PROT_READ , MAP_PRIVATE , fileno( stdin ) , 0 ) ;
+        if ( mapped_address != MAP_FAILED )
         {
-            input_line.clear( ) ;
+            madvise( mapped_address , (size_t) file_status.st_size , MADV_SEQUENTIAL ) ;
+            global_input_text_pointer = (const char *) mapped_address ;
+            global_input_text_length = (long) file_status.st_size ;
+            global_true_or_false_input_is_memory_mapped = global_true ;
+            global_true_or_false_input_reached_end_of_file = global_true ;
+            if ( global_logging_info == global_true ) { log_out << "[memory-mapped input file, length " << global_input_text_length << "]" << std::endl ; } ;
+            return ;
         }
-        if ( global_logging_info == global_true ) { log_out << std::endl << "[input line: " << input_line << "]" ; } ;
-        char input_line_c_version[ 2000 ] = "" ;
-        std::size_t line_length = std::min( 2000 , (int) input_line.length() ) ;
-        std::size_t line_length_copied = input_line.copy( input_line_c_version , line_length , 0 ) ;
-        input_line_c_version[ line_length_copied ] = '\0' ;
+    }
+#endif
 
 
 // -----------------------------------------------
-//  Begin loop to get first/next space-delimited
-//  word (of text) from the input line.  It must
-//  be an integer.
+//  Otherwise prepare to read large blocks of text
+//  from standard input.
 
-        char * pointer_to_word ;
-        // reminder: strtok modifies the string
-        pointer_to_word = strtok( input_line_c_version , " ,." ) ;
-        while ( pointer_to_word != NULL )
-        {
-            input_text_word = pointer_to_word ;
+    global_input_block_buffer.resize( global_input_block_size ) ;
+    global_input_text_pointer = &global_input_block_buffer[ 0 ] ;
 
 
 // -----------------------------------------------
-//  Attempt to convert the text word into an
-//  integer.  If this conversion is not
-//  successful, indicate an error.
-
-            global_current_voteinfo_number = 0 ;
-            try
-            {
-                global_current_voteinfo_number = convert_text_to_integer( pointer_to_word ) ;
-            }
-            catch( ... )
-            {
-                log_out << "[error, input line contains non-numeric characters: " << pointer_to_word << "]" << std::endl ;
-                std::cout << "Error: Input line contains non-numeric characters: " << pointer_to_word << std::endl ;
-                error_count ++ ;
-            }
-
+//  End of function open_input_text.
 
-// -----------------------------------------------
-//  Handle one voteinfo number, which is either a
-//  code expressed as a negative integer, or is a
-//  positive integer.  If the text is not an
-//  integer, or if the text is the integer zero,
-//  ignore it.
+    return ;
 
-            if ( global_current_voteinfo_number != 0 )
-            {
-                handle_one_voteinfo_number( ) ;
-            }
+}
 
 
 // -----------------------------------------------
-//  If there are errors, report them.  If there
-//  are lots of errors, exit extra early.
+// -----------------------------------------------
+//     close_input_text
+//
+//  Releases the memory used to hold the input
+//  text.
 
-            if ( global_possible_error_message.length() > 3 )
-            {
-                log_out << std::endl << "[error, message is: " << global_possible_error_message << "]" << std::endl ;
-                std::cout << "Error, error message is: " << global_possible_error_message << std::endl ;
-                error_count ++ ;
-                global_possible_error_message = "" ;
-            }
-            if ( error_count > 10 )
-            {
-                log_out << std::endl << "[too many errors to log, exiting early]" << std::endl ;
-                std::cout << "Too many errors to log, exiting early." << std::endl ;
-                exit( EXIT_FAILURE ) ;
-            }
+void close_input_text( )
+{
+
+#ifdef RCIPE_STV_USE_MEMORY_MAPPED_INPUT
+    if ( global_true_or_false_input_is_memory_mapped == global_true )
+    {
+        munmap( (void *) global_input_text_pointer , (size_t) global_input_text_length ) ;
+    }
+#endif
+    global_true_or_false_input_is_memory_mapped = global_false ;
+    global_input_text_pointer = NULL ;
+    global_input_text_length = 0 ;
+    global_input_text_position = 0 ;
+    std::vector< char >( ).swap( global_input_block_buffer ) ;
 
 
 // -----------------------------------------------
-//  Repeat the loop for the next word (within the line).
+//  End of function close_input_text.
 
-            global_previous_voteinfo_number = global_current_voteinfo_number ;
-            pointer_to_word = strtok( NULL, " ,." ) ;
-        }
+    return ;
+
+}
 
 
 // -----------------------------------------------
-//  Repeat the loop for the next line of data from
-//  the input file.
+// -----------------------------------------------
+//     get_next_input_line
+//
+//  Identifies the next line of input text,
+//  without copying it, by putting a pointer to
+//  its first character into
+//  global_input_line_start and its length
+//  (excluding the newline character) into
+//  global_input_line_length.  Returns global_false
+//  when there are no more lines.
+//
+//  When reading blocks from standard input, a
+//  partial line at the end of the buffer is moved
+//  to the beginning of the buffer before the next
+//  block is read, and the buffer is enlarged if
+//  a single line does not fit.  As a result there
+//  is no limit on the length of a line.
+
+int get_next_input_line( )
+{
 
-    }
-    if ( global_logging_info == global_true ) { log_out << "[done getting input data]" << std::endl ; }
+    const char * pointer_to_newline ;
+    long remaining_length ;
+    long count_of_characters_read ;
 
 
 // -----------------------------------------------
-//  If there were any data errors, exit now.
+//  Begin a loop that repeats only when more text
+//  must be read from standard input.
 
-    if ( error_count > 0 )
+    while ( 1 )
     {
-        log_out << std::endl << "[encountered one or more fatal data-input errors]" << std::endl ;
-        std::cout << "Encountered one or more fatal data-input errors, exiting now." << std::endl ;
-        exit( EXIT_FAILURE ) ;
-    }
 
 
 // -----------------------------------------------
-//  Log the number of ballot groups.
+//  If the remaining text contains a newline
+//  character, identify the line that ends there.
 
-    if ( global_logging_info == global_true ) { log_out << "[" << global_total_count_of_ballot_groups << " ballot groups]" << std::endl ; } ;
+        remaining_length = global_input_text_length - global_input_text_position ;
+        pointer_to_newline = NULL ;
+        if ( remaining_length > 0 )
+        {
+            pointer_to_newline = (const char *) memchr( global_input_text_pointer + global_input_text_position , '\n' , (size_t) remaining_length ) ;
+        }
+        if ( pointer_to_newline != NULL )
+        {
+            global_input_line_start = global_input_text_pointer + global_input_text_position ;
+            global_input_line_length = (long) ( pointer_to_newline - global_input_line_start ) ;
+            global_input_text_position += global_input_line_length + 1 ;
+            return global_true ;
+        }
 
 
 // -----------------------------------------------
-//  Put into the voteinfo ballot codes the code
-//  that indicates the end of the ballots.
+//  If the end of the input has been reached, the
+//  remaining text, if any, is the last line.
 
-    global_pointer_to_voteinfo_number ++ ;
-    global_vote_info_list[ global_pointer_to_voteinfo_number ] = global_voteinfo_code_for_end_of_all_vote_info ;
+        if ( global_true_or_false_input_reached_end_of_file == global_true )
+        {
+            if ( remaining_length <= 0 )
+            {
+                return global_false ;
+            }
+            global_input_line_start = global_input_text_pointer + global_input_text_position ;
+            global_input_line_length = remaining_length ;
+            global_input_text_position = global_input_text_length ;
+            return global_true ;
+        }
 
 
 // -----------------------------------------------
-//  Specify the length of the list that now holds
-//  the ballot data.
+//  Move the partial line to the beginning of the
+//  buffer, enlarge the buffer if it is full, and
+//  read the next block of text.
 
-    global_pointer_to_end_of_voteinfo_numbers = global_pointer_to_voteinfo_number ;
+        if ( global_input_text_position > 0 )
+        {
+            if ( remaining_length > 0 )
+            {
+                memmove( &global_input_block_buffer[ 0 ] , &global_input_block_buffer[ global_input_text_position ] , (size_t) remaining_length ) ;
+            }
+            global_input_text_position = 0 ;
+            global_input_text_length = remaining_length ;
+        }
+        if ( global_input_text_length >= (long) global_input_block_buffer.size( ) )
+        {
+            global_input_block_buffer.resize( global_input_block_buffer.size( ) * 2 ) ;
+        }
+        global_input_text_pointer = &global_input_block_buffer[ 0 ] ;
+        count_of_characters_read = (long) fread( &global_input_block_buffer[ global_input_text_length ] , 1 , global_input_block_buffer.size( ) - global_input_text_length , stdin ) ;
+        if ( count_of_characters_read <= 0 )
+        {
+            global_true_or_false_input_reached_end_of_file = global_true ;
+        }
+        global_input_text_length += count_of_characters_read ;
 
 
 // -----------------------------------------------
-//  If a meaningful number of ballots were not
-//  found, indicate this no-data error.
+//  Repeat the loop to look for the end of the
+//  line within the new text.
 
-    if ( global_total_count_of_ballot_groups < 2 )
-    {
-        if ( global_logging_info == global_true ) { log_out << "[error, input file does not contain any ballot data]" ; } ;
-        std::cout << "Error, input file does not contain any ballot data." << std::endl ;
-        exit( EXIT_FAILURE ) ;
     }
 
 
 // -----------------------------------------------
-//  End of function read_data.
-
-    return ;
+//  End of function get_next_input_line.
 
 }
 
 
 // -----------------------------------------------
 // -----------------------------------------------
-//    point_to_next_ballot_group
+//     get_next_input_byte
 //
-//  Points to the next ballot group without
-//  getting any info from the skipped group of
-//  identical ballots.
+//  Gets the next byte of the input, reading the
+//  next block of input when needed.  Returns -1
+//  when there are no more bytes.
 
-void point_to_next_ballot_group( )
+int get_next_input_byte( )
 {
 
+    long count_of_characters_read ;
+
 
 // -----------------------------------------------
-//  If the pointer is already at the end of the
-//  ballots, return.
+//  If the next byte is available, return it.
 
-    if ( global_pointer_to_voteinfo_number >= global_pointer_to_end_of_voteinfo_numbers )
+    if ( global_input_text_position < global_input_text_length )
     {
-        return ;
+        global_input_text_position ++ ;
+        return (unsigned char) global_input_text_pointer[ global_input_text_position - 1 ] ;
     }
 
 
 // -----------------------------------------------
-//  Skip the ballot repeat count.
+//  If the end of the input has been reached,
+//  indicate there are no more bytes.
 
-    global_pointer_to_voteinfo_number ++ ;
-    global_pointer_to_voteinfo_number ++ ;
+    if ( global_true_or_false_input_reached_end_of_file == global_true )
+    {
+        return -1 ;
+    }
 
 
 // -----------------------------------------------
-//  Loop through the voteinfo codes until the
-//  beginning of the next ballot is reached.
+//  Read the next block of input into the buffer,
+//  then return its first byte.
 
-    while ( global_pointer_to_voteinfo_number < global_pointer_to_end_of_voteinfo_numbers )
+    global_input_text_pointer = &global_input_block_buffer[ 0 ] ;
+    global_input_text_position = 0 ;
+    count_of_characters_read = (long) fread( &global_input_block_buffer[ 0 ] , 1 , global_input_block_buffer.size( ) , stdin ) ;
+    if ( count_of_characters_read <= 0 )
     {
-        global_current_voteinfo_number = global_vote_info_list[ global_pointer_to_voteinfo_number ] ;
-        if ( ( global_current_voteinfo_number == global_voteinfo_code_for_ballot_count ) || ( global_current_voteinfo_number == global_voteinfo_code_for_end_of_all_vote_info ) )
-        {
-            break ;
-        }
-        global_pointer_to_voteinfo_number ++ ;
+        global_input_text_length = 0 ;
+        global_true_or_false_input_reached_end_of_file = global_true ;
+        return -1 ;
     }
+    global_input_text_length = count_of_characters_read ;
+    global_input_text_position = 1 ;
+    return (unsigned char) global_input_text_pointer[ 0 ] ;
 
 
 // -----------------------------------------------
-//  End of function point_to_next_ballot_group.
-
-    return ;
+//  End of function get_next_input_byte.
 
 }
 
 
 // -----------------------------------------------
 // -----------------------------------------------
-//    get_candidate_ranks_from_one_ballot_group
+//     input_is_binary_voteinfo
 //
-//  Gets the candidate rankings from the next
-//  ballot group.  Every ballot in the group has
-//  the same specified preferences.  This grouping
-//  allows them to be processed together.
+//  Returns global_true if the input begins with
+//  the signature of the binary voteinfo format.
+//  The signature is not consumed.
 
-int get_candidate_ranks_from_one_ballot_group( )
+int input_is_binary_voteinfo( )
 {
 
-    int candidate_number ;
-    int preference_level ;
-
-    std::string text_ballot_info ;
+    long count_of_characters_read ;
 
 
 // -----------------------------------------------
-//  If the pointer is already at the end of the
-//  ballots, return with a value of zero.
+//  When reading blocks of input, ensure that the
+//  buffer contains enough bytes to check the
+//  signature.
 
-    if ( global_pointer_to_voteinfo_number >= global_pointer_to_end_of_voteinfo_numbers )
+    while ( ( global_input_text_length < 4 ) && ( global_true_or_false_input_reached_end_of_file == global_false ) )
     {
-        global_ballot_info_repeat_count = 0 ;
-        log_out << "[voteinfo pointer has already reached the end of the ballots]" << std::endl ;
-        return 0 ;
+        count_of_characters_read = (long) fread( &global_input_block_buffer[ global_input_text_length ] , 1 , global_input_block_buffer.size( ) - global_input_text_length , stdin ) ;
+        if ( count_of_characters_read <= 0 )
+        {
+            global_true_or_false_input_reached_end_of_file = global_true ;
+        } else
+        {
+            global_input_text_length += count_of_characters_read ;
+        }
     }
 
 
 // -----------------------------------------------
-//  If the voteinfo pointer does not already point
-//  to the ballot repeat count, that is a fatal
-//  error.
+//  Check the signature.
 
-    if ( global_vote_info_list[ global_pointer_to_voteinfo_number ] != global_voteinfo_code_for_ballot_count )
+    if ( ( global_input_text_length >= 4 ) && ( memcmp( global_input_text_pointer , "VFVI" , 4 ) == 0 ) )
     {
-        log_out << "[error, bug has been introduced into code, expected ballot repeat count voteinfo code, but found something else]" << std::endl ;
-        std::cout << "Error: Bug has been introduced into code, expected ballot repeat count voteinfo code, but found something else.]" << std::endl ;
-        exit( EXIT_FAILURE ) ;
+        return global_true ;
     }
+    return global_false ;
 
 
 // -----------------------------------------------
-//  If the number of ballot groups exceeds the
-//  assigned storage capacity, indicate a fatal
-//  error.
+//  End of function input_is_binary_voteinfo.
 
-    if ( global_ballot_group_pointer >= global_maximum_number_of_ballot_groups )
-    {
-        if ( global_logging_info == global_true ) { log_out << "[error, number of ballot groups exceeds assigned storage capacity limit, which is " << global_maximum_number_of_ballot_groups << "]" << std::endl ; } ;
-        log_out << "[Error: Number of ballot groups exceeds assigned storage capacity limit, which is " << global_maximum_number_of_ballot_groups << "]" << std::endl ;
-        std::cout << "Error: Number of ballot groups exceeds assigned storage capacity limit, which is " << convert_integer_to_text( global_maximum_number_of_ballot_groups ) << ".]" << std::endl ;
-        exit( EXIT_FAILURE ) ;
-    }
+}
 
 
 // -----------------------------------------------
-//  In case any of the candidate numbers are not
-//  encountered, initialize all the preference
-//  levels to a very low ranking level.
+// -----------------------------------------------
+//     get_next_binary_unsigned_number
+//
+//  Gets the next variable-length unsigned number
+//  from the binary input.  If the input ends
+//  within the number, the flag
+//  global_true_or_false_binary_input_is_truncated
+//  is set.
 
-    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+unsigned int get_next_binary_unsigned_number( )
+{
+
+    unsigned int number_value ;
+    int next_byte ;
+    int bit_shift ;
+
+    number_value = 0 ;
+    for ( bit_shift = 0 ; bit_shift < 35 ; bit_shift += 7 )
     {
-        global_ballot_preference_for_candidate[ candidate_number ] = 200 ;
+        next_byte = get_next_input_byte( ) ;
+        if ( next_byte < 0 )
+        {
+            global_true_or_false_binary_input_is_truncated = global_true ;
+            return 0 ;
+        }
+        number_value |= ( (unsigned int) ( next_byte & 127 ) ) << bit_shift ;
+        if ( ( next_byte & 128 ) == 0 )
+        {
+            return number_value ;
+        }
     }
+    global_true_or_false_binary_input_is_truncated = global_true ;
+    return 0 ;
 
 
 // -----------------------------------------------
-//  Get the ballot repeat count, which is the
-//  number of ballots that are marked with the
-//  same preference pattern.
+//  End of function get_next_binary_unsigned_number.
 
-    global_pointer_to_voteinfo_number ++ ;
-    global_ballot_info_repeat_count = global_vote_info_list[ global_pointer_to_voteinfo_number ] ;
-    global_pointer_to_voteinfo_number ++ ;
+}
 
 
 // -----------------------------------------------
-//  If this is the first time getting the ballot
-//  count for this group, save this ballot count
-//  as the initial influence count for this ballot
-//  group.
+// -----------------------------------------------
+//     put_binary_unsigned_number
+//
+//  Writes one variable-length unsigned number to
+//  the standard output.
+
+void put_binary_unsigned_number( unsigned int number_value )
+{
 
-    if ( global_need_to_initialize_group_ballot_count == global_true )
+    while ( number_value >= 128 )
     {
-        global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] = global_ballot_info_repeat_count ;
+        std::cout.put( (char) ( ( number_value & 127 ) | 128 ) ) ;
+        number_value = number_value >> 7 ;
     }
+    std::cout.put( (char) number_value ) ;
 
 
 // -----------------------------------------------
-//  Begin a loop that gets the voteinfo codes and
-//  candidate numbers within the ballot.
+//  End of function put_binary_unsigned_number.
 
-    preference_level = 1 ;
-    while ( global_pointer_to_voteinfo_number <= global_pointer_to_end_of_voteinfo_numbers )
-    {
+}
 
 
 // -----------------------------------------------
-//  Get the current voteinfo number.
+// -----------------------------------------------
+//     put_binary_voteinfo_header
+//
+//  Writes the beginning of a binary voteinfo
+//  file to the standard output.
 
-        global_current_voteinfo_number = global_vote_info_list[ global_pointer_to_voteinfo_number ] ;
-//        if ( global_logging_info == global_true ) { log_out << "[" << global_pointer_to_voteinfo_number << ": " << global_current_voteinfo_number << "]" ; } ;
+void put_binary_voteinfo_header( int content_type , int case_number , int question_count , int choice_count , int count_of_numbers )
+{
 
 
 // -----------------------------------------------
-//  If the end of the ballot has been reached,
-//  leave the pointer pointing to the beginning of
-//  the next ballot, and exit the loop.
+//  On Windows, write standard output in binary
+//  mode.
 
-        if ( ( global_current_voteinfo_number == global_voteinfo_code_for_ballot_count ) || ( global_current_voteinfo_number == global_voteinfo_code_for_end_of_all_vote_info ) )
-        {
-            break ;
-        }
+#if defined( _WIN32 )
+    _setmode( _fileno( stdout ) , _O_BINARY ) ;
+#endif
 
 
 // -----------------------------------------------
-//  Adjust the preference level at tied levels.
+//  Write the signature, version, content type,
+//  reserved bytes, and the counts.
 
-        if ( global_current_voteinfo_number == global_voteinfo_code_for_tie )
-        {
-            preference_level -- ;
-            text_ballot_info += " tie" ;
-        }
+    std::cout.write( "VFVI" , 4 ) ;
+    std::cout.put( (char) global_binary_voteinfo_format_version ) ;
+    std::cout.put( (char) content_type ) ;
+    std::cout.put( (char) 0 ) ;
+    std::cout.put( (char) 0 ) ;
+    put_binary_unsigned_number( (unsigned int) case_number ) ;
+    put_binary_unsigned_number( (unsigned int) question_count ) ;
+    put_binary_unsigned_number( (unsigned int) choice_count ) ;
+    put_binary_unsigned_number( (unsigned int) count_of_numbers ) ;
 
 
 // -----------------------------------------------
-//  For a candidate number, determine its preference
+//  End of function put_binary_voteinfo_header.
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//    handle_one_input_number
+//
+//  Handles the voteinfo number that was just read
+//  from the input file, and reports any errors.
+//  If there are lots of errors, exits extra
+//  early.
+
+void handle_one_input_number( )
+{
+
+
+// -----------------------------------------------
+//  Handle one voteinfo number, which is either a
+//  code expressed as a negative integer, or is a
+//  positive integer.  If the text is not an
+//  integer, or if the text is the integer zero,
+//  ignore it.
+
+    if ( global_current_voteinfo_number != 0 )
+    {
+        handle_one_voteinfo_number( ) ;
+    }
+
+
+// -----------------------------------------------
+//  If there are errors, report them.  If there
+//  are lots of errors, exit extra early.
+
+    if ( global_possible_error_message.length() > 3 )
+    {
+        log_out << std::endl << "[error, message is: " << global_possible_error_message << "]" << std::endl ;
+        std::cout << "Error, error message is: " << global_possible_error_message << std::endl ;
+        global_input_error_count ++ ;
+        global_possible_error_message = "" ;
+    }
+    if ( global_input_error_count > 10 )
+    {
+        log_out << std::endl << "[too many errors to log, exiting early]" << std::endl ;
+        std::cout << "Too many errors to log, exiting early." << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+    global_previous_voteinfo_number = global_current_voteinfo_number ;
+
+
+// -----------------------------------------------
+//  End of function handle_one_input_number.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//    read_binary_voteinfo_numbers
+//
+//  Reads the voteinfo numbers from input that is
+//  in the binary voteinfo format.  The header
+//  counts for the case, questions, and candidates
+//  are only logged because the voteinfo numbers
+//  contain the same information.
+
+void read_binary_voteinfo_numbers( )
+{
+
+    int format_version ;
+    int content_type ;
+    int header_case_number ;
+    int header_question_count ;
+    int header_candidate_count ;
+    int count_of_numbers ;
+    int input_number_count ;
+    unsigned int encoded_number ;
+
+
+// -----------------------------------------------
+//  Skip the signature, then get the version,
+//  content type, and counts.
+
+    global_true_or_false_binary_input_is_truncated = global_false ;
+    global_input_text_position = 4 ;
+    format_version = get_next_input_byte( ) ;
+    content_type = get_next_input_byte( ) ;
+    get_next_input_byte( ) ;
+    get_next_input_byte( ) ;
+    header_case_number = (int) get_next_binary_unsigned_number( ) ;
+    header_question_count = (int) get_next_binary_unsigned_number( ) ;
+    header_candidate_count = (int) get_next_binary_unsigned_number( ) ;
+    count_of_numbers = (int) get_next_binary_unsigned_number( ) ;
+    if ( global_logging_info == global_true ) { log_out << "[binary input, version " << format_version << ", content type " << content_type << ", case " << header_case_number << ", " << header_question_count << " questions, " << header_candidate_count << " candidates, " << count_of_numbers << " numbers]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  Reject a format version that is not known, or
+//  content that is not ballot input.
+
+    if ( ( format_version != global_binary_voteinfo_format_version ) || ( content_type != global_binary_content_type_voteinfo_input ) || ( global_true_or_false_binary_input_is_truncated == global_true ) )
+    {
+        log_out << "[error, binary input has unsupported version (" << format_version << ") or content type (" << content_type << ")]" << std::endl ;
+        std::cout << "Error: Binary input has unsupported version or content type." << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+
+
+// -----------------------------------------------
+//  Get and handle each voteinfo number.
+
+    for ( input_number_count = 0 ; input_number_count < count_of_numbers ; input_number_count ++ )
+    {
+        encoded_number = get_next_binary_unsigned_number( ) ;
+        if ( global_true_or_false_binary_input_is_truncated == global_true )
+        {
+            log_out << "[error, binary input ends after " << input_number_count << " of " << count_of_numbers << " numbers]" << std::endl ;
+            std::cout << "Error: Binary input ends early." << std::endl ;
+            exit( EXIT_FAILURE ) ;
+        }
+        global_current_voteinfo_number = (int) ( encoded_number >> 1 ) ^ - (int) ( encoded_number & 1 ) ;
+        handle_one_input_number( ) ;
+    }
+
+
+// -----------------------------------------------
+//  Ignore anything that follows the numbers.
+
+    global_input_text_position = global_input_text_length ;
+    global_true_or_false_input_reached_end_of_file = global_true ;
+
+
+// -----------------------------------------------
+//  End of function read_binary_voteinfo_numbers.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//         read_data
+//
+//  Reads numbers, including codes (which are
+//  negative numbers) from the standard input
+//  file.  These numbers supply ballot data and
+//  specify what to calculate and what results to
+//  include in the results.  The codes that
+//  specify ballot marks are saved in a list where
+//  they can be accessed repeatedly.
+
+void read_data( )
+{
+
+    int candidate_number ;
+
+    const char * pointer_to_word ;
+    const char * pointer_to_end_of_line ;
+    const char * pointer_to_null_character ;
+    long word_length ;
+
+
+// -----------------------------------------------
+//  Initialization.
+
+    global_input_error_count = 0 ;
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        global_tally_uses_of_candidate_number[ candidate_number ] = 0 ;
+    }
+
+
+// -----------------------------------------------
+//  Indicate the current status.
+
+    if ( global_logging_info == global_true ) { log_out << "[about to start checking vote-info numbers]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  Prepare to read the input file, which is
+//  "standard input" (which means it's the input
+//  file specified on the command line).
+
+    open_input_text( ) ;
+
+
+// -----------------------------------------------
+//  If the input is in the binary voteinfo format,
+//  read all the numbers now.  No lines of text
+//  remain after that.
+
+    if ( input_is_binary_voteinfo( ) == global_true )
+    {
+        read_binary_voteinfo_numbers( ) ;
+    }
+
+
+// -----------------------------------------------
+//  Begin loop to handle one line from the input
+//  file.  The line is scanned where it is,
+//  without being copied, and there is no limit
+//  on its length.
+//
+//  Although each code can be on a different line,
+//  or all the codes and tokens can be on a single
+//  line, for clarity each ballot can be on a
+//  separate line.
+
+    while ( get_next_input_line( ) == global_true )
+    {
+        global_input_line_number ++ ;
+
+
+// -----------------------------------------------
+//  Ignore white space at the end of the line.  A
+//  null character ends the line early.
+
+        pointer_to_end_of_line = global_input_line_start + global_input_line_length ;
+        while ( ( pointer_to_end_of_line > global_input_line_start ) && ( ( pointer_to_end_of_line[ -1 ] == ' ' ) || ( pointer_to_end_of_line[ -1 ] == '\t' ) || ( pointer_to_end_of_line[ -1 ] == '\n' ) || ( pointer_to_end_of_line[ -1 ] == '\r' ) ) )
+        {
+            pointer_to_end_of_line -- ;
+        }
+        if ( global_logging_info == global_true ) { log_out << std::endl << "[input line: " ; log_out.write( global_input_line_start , pointer_to_end_of_line - global_input_line_start ) ; log_out << "]" ; } ;
+        pointer_to_null_character = (const char *) memchr( global_input_line_start , '\0' , (size_t) ( pointer_to_end_of_line - global_input_line_start ) ) ;
+        if ( pointer_to_null_character != NULL )
+        {
+            pointer_to_end_of_line = pointer_to_null_character ;
+        }
+
+
+// -----------------------------------------------
+//  Begin loop to get first/next word (of text)
+//  from the input line.  Words are separated by
+//  spaces, commas, and periods.  Each word must
+//  be an integer.
+
+        pointer_to_word = global_input_line_start ;
+        while ( pointer_to_word < pointer_to_end_of_line )
+        {
+            if ( ( *pointer_to_word == ' ' ) || ( *pointer_to_word == ',' ) || ( *pointer_to_word == '.' ) )
+            {
+                pointer_to_word ++ ;
+                continue ;
+            }
+            word_length = 0 ;
+            while ( ( pointer_to_word + word_length < pointer_to_end_of_line ) && ( pointer_to_word[ word_length ] != ' ' ) && ( pointer_to_word[ word_length ] != ',' ) && ( pointer_to_word[ word_length ] != '.' ) )
+            {
+                word_length ++ ;
+            }
+
+
+// -----------------------------------------------
+//  Convert the text word into an integer.  Text
+//  that is not a number converts to zero.
+
+            global_current_voteinfo_number = convert_text_span_to_integer( pointer_to_word , word_length ) ;
+
+            handle_one_input_number( ) ;
+
+
+// -----------------------------------------------
+//  Repeat the loop for the next word (within the line).
+
+            pointer_to_word += word_length ;
+        }
+
+
+// -----------------------------------------------
+//  Repeat the loop for the next line of data from
+//  the input file.
+
+    }
+    close_input_text( ) ;
+    if ( global_logging_info == global_true ) { log_out << "[done getting input data]" << std::endl ; }
+
+
+// -----------------------------------------------
+//  If there were any data errors, exit now.
+
+    if ( global_input_error_count > 0 )
+    {
+        log_out << std::endl << "[encountered one or more fatal data-input errors]" << std::endl ;
+        std::cout << "Encountered one or more fatal data-input errors, exiting now." << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+
+
+// -----------------------------------------------
+//  Log the number of ballot groups.
+
+    if ( global_logging_info == global_true ) { log_out << "[" << global_total_count_of_ballot_groups << " ballot groups]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  Put into the voteinfo ballot codes the code
+//  that indicates the end of the ballots.
+
+    global_pointer_to_voteinfo_number ++ ;
+    put_vote_info_number( global_pointer_to_voteinfo_number , global_voteinfo_code_for_end_of_all_vote_info ) ;
+
+
+// -----------------------------------------------
+//  Specify the length of the list that now holds
+//  the ballot data.
+
+    global_pointer_to_end_of_voteinfo_numbers = global_pointer_to_voteinfo_number ;
+
+
+// -----------------------------------------------
+//  If a meaningful number of ballots were not
+//  found, indicate this no-data error.
+
+    if ( global_total_count_of_ballot_groups < 2 )
+    {
+        if ( global_logging_info == global_true ) { log_out << "[error, input file does not contain any ballot data]" ; } ;
+        std::cout << "Error, input file does not contain any ballot data." << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+
+
+// -----------------------------------------------
+//  End of function read_data.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//    compile_ballot_group_table
+//
+//  Compiles the ballot info, which was read as a
+//  list of voteinfo numbers, into the
+//  ballot-group table.  Each group of identical
+//  ballots gets one row that contains the
+//  preference level of every candidate, plus its
+//  ballot repeat count.  This is done just once,
+//  so the counting cycles do not need to re-read
+//  the voteinfo numbers.
+
+void compile_ballot_group_table( )
+{
+
+    int pointer ;
+    int ballot_group_number ;
+    int candidate_number ;
+    int preference_level ;
+    int position_in_row ;
+    long pointer_to_row ;
+
+
+// -----------------------------------------------
+//  Create the table, with the row for ballot
+//  group zero not used.  In case any of the
+//  candidate numbers are not encountered,
+//  initialize all the preference levels to a very
+//  low ranking level.
+
+    global_length_of_ballot_group_row = global_number_of_candidates + 1 ;
+    global_ballot_count_for_ballot_group.assign( global_total_count_of_ballot_groups + 1 , 0 ) ;
+    global_preference_level_in_ballot_group_table.assign( (size_t) ( global_total_count_of_ballot_groups + 1 ) * global_length_of_ballot_group_row , 200 ) ;
+    global_candidate_in_ballot_group_order.assign( (size_t) ( global_total_count_of_ballot_groups + 1 ) * global_length_of_ballot_group_row , 0 ) ;
+
+
+// -----------------------------------------------
+//  Begin a loop that gets the voteinfo codes and
+//  candidate numbers within all the ballots.
+
+    ballot_group_number = 0 ;
+    pointer_to_row = 0 ;
+    position_in_row = 0 ;
+    preference_level = 1 ;
+    for ( pointer = 1 ; pointer < global_pointer_to_end_of_voteinfo_numbers ; pointer ++ )
+    {
+        global_current_voteinfo_number = get_vote_info_number( pointer ) ;
+
+
+// -----------------------------------------------
+//  At the start of each ballot group, get the
+//  ballot repeat count, which is the number of
+//  ballots that are marked with the same
+//  preference pattern.  If there are more ballot
+//  groups than were counted while reading them,
+//  that is a fatal error.
+
+        if ( global_current_voteinfo_number == global_voteinfo_code_for_ballot_count )
+        {
+            ballot_group_number ++ ;
+            if ( ballot_group_number > global_total_count_of_ballot_groups )
+            {
+                log_out << "[error, bug has been introduced into code, ballot group number " << ballot_group_number << " exceeds the number of ballot groups, which is " << global_total_count_of_ballot_groups << "]" << std::endl ;
+                std::cout << "Error: Bug has been introduced into code, ballot group number exceeds the number of ballot groups.]" << std::endl ;
+                exit( EXIT_FAILURE ) ;
+            }
+            pointer ++ ;
+            global_ballot_count_for_ballot_group[ ballot_group_number ] = get_vote_info_number( pointer ) ;
+            pointer_to_row = (long) ballot_group_number * global_length_of_ballot_group_row ;
+            position_in_row = 0 ;
+            preference_level = 1 ;
+            continue ;
+        }
+
+
+// -----------------------------------------------
+//  Adjust the preference level at tied levels.
+
+        if ( global_current_voteinfo_number == global_voteinfo_code_for_tie )
+        {
+            preference_level -- ;
+        }
+
+
+// -----------------------------------------------
+//  For a candidate number, save its preference
+//  level.  Also save the candidate numbers in the
+//  sequence in which they appear on the ballot.
+
+        if ( ( global_current_voteinfo_number > 0 ) && ( ballot_group_number > 0 ) )
+        {
+            candidate_number = global_current_voteinfo_number ;
+            global_preference_level_in_ballot_group_table[ pointer_to_row + candidate_number ] = preference_level ;
+            preference_level ++ ;
+            if ( position_in_row < global_number_of_candidates )
+            {
+                position_in_row ++ ;
+                global_candidate_in_ballot_group_order[ pointer_to_row + position_in_row ] = candidate_number ;
+            }
+        }
+
+
+// -----------------------------------------------
+//  Repeat the loop to handle the next voteinfo
+//  number.
+
+    }
+
+
+// -----------------------------------------------
+//  If fewer ballot groups were found than were
+//  counted while reading them, that is a fatal
+//  error.
+
+    if ( ballot_group_number != global_total_count_of_ballot_groups )
+    {
+        log_out << "[error, bug has been introduced into code, compiled " << ballot_group_number << " ballot groups, but read " << global_total_count_of_ballot_groups << " ballot groups]" << std::endl ;
+        std::cout << "Error: Bug has been introduced into code, compiled ballot group count does not match.]" << std::endl ;
+        exit( EXIT_FAILURE ) ;
+    }
+
+
+// -----------------------------------------------
+//  Log each ballot group's ballot count and
+//  candidate preference levels.
+
+    if ( global_logging_info == global_true )
+    {
+        for ( ballot_group_number = 1 ; ballot_group_number <= global_total_count_of_ballot_groups ; ballot_group_number ++ )
+        {
+            pointer_to_row = (long) ballot_group_number * global_length_of_ballot_group_row ;
+            log_out << "[group " << ballot_group_number << " bc " << global_ballot_count_for_ballot_group[ ballot_group_number ] << " levels" ;
+            for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+            {
+                log_out << " " << global_preference_level_in_ballot_group_table[ pointer_to_row + candidate_number ] ;
+            }
+            log_out << "]" << std::endl ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  The voteinfo numbers are no longer needed, so
+//  release their storage space.
+
+    global_vote_info_chunks.clear( ) ;
+
+
+// -----------------------------------------------
+//  End of function compile_ballot_group_table.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//        count_ballot_groups_in_shard
+//
+//  Counts the ballot groups in one shard -- from
+//  the first supplied ballot group number up to,
+//  but not including, the last supplied ballot
+//  group number.  The remaining ballot count of a
+//  ballot group that has just one top-ranked
+//  candidate is added to this shard's count for
+//  that candidate.  A ballot group that has more
+//  than one top-ranked candidate is added to this
+//  shard's list of shared ballot groups.  This
+//  function runs in its own thread, so it only
+//  changes the lists for its own shard and the
+//  remaining ballot counts of its own ballot
+//  groups, and it does not write to the log
+//  file.
+
+void count_ballot_groups_in_shard( int shard_number , int first_ballot_group_number , int last_ballot_group_number )
+{
+
+    int ballot_group_number ;
+    int candidate_number ;
+    int * ballot_count_for_single_top_candidate ;
+
+
+// -----------------------------------------------
+//  Clear the lists for this shard.
+
+    ballot_count_for_single_top_candidate = global_shard_ballot_count_for_single_top_candidate[ shard_number ] ;
+    for ( candidate_number = 0 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        ballot_count_for_single_top_candidate[ candidate_number ] = 0 ;
+    }
+    global_shard_list_of_shared_ballot_groups[ shard_number ].clear( ) ;
+
+
+// -----------------------------------------------
+//  Begin a loop that handles each ballot group in
+//  this shard.
+
+    for ( ballot_group_number = first_ballot_group_number ; ballot_group_number < last_ballot_group_number ; ballot_group_number ++ )
+    {
+
+
+// -----------------------------------------------
+//  If this is the first counting cycle, save the
+//  ballot count as the initial influence count
+//  for this ballot group.
+
+        if ( global_need_to_initialize_group_ballot_count == global_true )
+        {
+            global_ballot_count_remaining_for_ballot_group[ ballot_group_number ] = global_ballot_count_for_ballot_group[ ballot_group_number ] ;
+        }
+
+
+// -----------------------------------------------
+//  If this ballot group has no more influence,
+//  skip it.
+
+        if ( global_ballot_count_remaining_for_ballot_group[ ballot_group_number ] <= 0 )
+        {
+            continue ;
+        }
+
+
+// -----------------------------------------------
+//  If just one candidate is top-ranked, add the
+//  remaining ballots to that candidate's count.
+//  Otherwise save this ballot group for adding
+//  to the top-ranking patterns.
+
+        if ( global_count_of_top_ranked_for_ballot_group[ ballot_group_number ] == 1 )
+        {
+            ballot_count_for_single_top_candidate[ global_top_ranked_candidate_for_ballot_group[ ballot_group_number ] ] += global_ballot_count_remaining_for_ballot_group[ ballot_group_number ] ;
+        } else
+        {
+            global_shard_list_of_shared_ballot_groups[ shard_number ].push_back( ballot_group_number ) ;
+        }
+
+
+// -----------------------------------------------
+//  Repeat the loop for the next ballot group.
+
+    }
+
+
+// -----------------------------------------------
+//  End of function count_ballot_groups_in_shard.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//          reset_tally_table
+//
+//  Create and initialize the tally table.
+
+void reset_tally_table( )
+{
+
+    int pair_counter ;
+    int first_candidate_number ;
+    int second_candidate_number ;
+
+
+// -----------------------------------------------
+//  Create the pairwise candidate counters.  If
+//  the storage limit is exceeded, indicate this
+//  by putting zero into the value
+//  global_pair_counter_maximum.
+
+    pair_counter = 0 ;
+    global_pair_counter_maximum = 0 ;
+    for ( first_candidate_number = 1 ; first_candidate_number < global_number_of_candidates ; first_candidate_number ++ )
+    {
+        if ( global_true_or_false_pairwise_consider_candidate[ first_candidate_number ] == global_true )
+        {
+            for ( second_candidate_number = first_candidate_number + 1 ; second_candidate_number <= global_number_of_candidates ; second_candidate_number ++ )
+            {
+                if ( global_true_or_false_pairwise_consider_candidate[ second_candidate_number ] == global_true )
+                {
+                    pair_counter ++ ;
+                    global_pair_counter_maximum ++ ;
+                    if ( global_pair_counter_maximum >= global_maximum_candidate_pairs )
+                    {
+                        global_pair_counter_maximum = 0 ;
+                        if ( global_logging_info == global_true ) { log_out << "[error, the number of candidates being pairwise counted exceeds the available storage space]" ; } ;
+                        return ;
+                    }
+                    global_first_candidate_number_in_pair[ pair_counter ] = first_candidate_number ;
+                    global_second_candidate_number_in_pair[ pair_counter ] = second_candidate_number ;
+                }
+            }
+        }
+    }
+
+
+// -----------------------------------------------
+//  If there were no candidates to pairwise
+//  compare, return with zero in the variable
+//  global_pair_counter_maximum.
+
+    if ( global_pair_counter_maximum == 0 )
+    {
+        return ;
+    }
+
+
+// -----------------------------------------------
+//  Create, and clear, the tally table.
+
+    for ( pair_counter = 1 ; pair_counter <= global_pair_counter_maximum ; pair_counter ++ )
+    {
+        global_tally_first_over_second_in_pair[ pair_counter ] = 0 ;
+        global_tally_second_over_first_in_pair[ pair_counter ] = 0 ;
+        global_tally_first_equal_second_in_pair[ pair_counter ] = 0 ;
+    }
+
+
+// -----------------------------------------------
+//  End of function reset_tally_table.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//        add_ballot_group_to_pairwise_counts
+//
+//  Adds a change in a ballot group's remaining
+//  ballot count to the supplied pairwise counts,
+//  which are either the pairwise counts or a
+//  shard's pairwise counts.  The change can be
+//  negative.  Only the pairs of candidates in the
+//  list of pairwise-counted candidates are
+//  updated.
+
+void add_ballot_group_to_pairwise_counts( int ballot_group_number , int ballot_count_change , int * pairwise_count_first_over_second )
+{
+
+    int first_pointer ;
+    int second_pointer ;
+    int first_candidate_number ;
+    int second_candidate_number ;
+    int first_preference_level ;
+    int second_preference_level ;
+    long pointer_to_row ;
+
+
+// -----------------------------------------------
+//  For each pair of candidates, add the change to
+//  the count for the candidate who is ranked
+//  higher.  Nothing is added for candidates who
+//  are ranked at the same preference level.
+//  Reminder: The preference level numbers are
+//  smallest for the highest-ranked candidates.
+
+    pointer_to_row = (long) ballot_group_number * global_length_of_ballot_group_row ;
+    for ( first_pointer = 1 ; first_pointer < global_count_of_pairwise_counted_candidates ; first_pointer ++ )
+    {
+        first_candidate_number = global_list_of_pairwise_counted_candidates[ first_pointer ] ;
+        first_preference_level = global_preference_level_in_ballot_group_table[ pointer_to_row + first_candidate_number ] ;
+        for ( second_pointer = first_pointer + 1 ; second_pointer <= global_count_of_pairwise_counted_candidates ; second_pointer ++ )
+        {
+            second_candidate_number = global_list_of_pairwise_counted_candidates[ second_pointer ] ;
+            second_preference_level = global_preference_level_in_ballot_group_table[ pointer_to_row + second_candidate_number ] ;
+            if ( first_preference_level < second_preference_level )
+            {
+                pairwise_count_first_over_second[ ( first_candidate_number * global_length_of_ballot_group_row ) + second_candidate_number ] += ballot_count_change ;
+            } else if ( first_preference_level > second_preference_level )
+            {
+                pairwise_count_first_over_second[ ( second_candidate_number * global_length_of_ballot_group_row ) + first_candidate_number ] += ballot_count_change ;
+            }
+        }
+    }
+
+
+// -----------------------------------------------
+//  End of function add_ballot_group_to_pairwise_counts.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//    add_changed_ballot_groups_in_shard
+//
+//  Adds the changes for the changed ballot groups
+//  in one shard -- from the first supplied
+//  position in the list of changed ballot groups
+//  up to, but not including, the last supplied
+//  position -- to that shard's pairwise counts.
+//  The last shard adds its changes directly to
+//  the pairwise counts, because no other thread
+//  changes them.  This function runs in its own
+//  thread, so it does not write to the log file.
+
+void add_changed_ballot_groups_in_shard( int shard_number , int first_position , int last_position , int is_last_shard )
+{
+
+    int position ;
+    int * pairwise_count_first_over_second ;
+
+
+// -----------------------------------------------
+//  Point to the pairwise counts for this shard,
+//  and clear them if they are not the main
+//  pairwise counts.
+
+    if ( is_last_shard == global_true )
+    {
+        pairwise_count_first_over_second = &global_pairwise_count_first_over_second[ 0 ] ;
+    } else
+    {
+        global_shard_pairwise_count_first_over_second[ shard_number ].assign( global_pairwise_count_first_over_second.size( ) , 0 ) ;
+        pairwise_count_first_over_second = &global_shard_pairwise_count_first_over_second[ shard_number ][ 0 ] ;
+    }
+
+
+// -----------------------------------------------
+//  Add the change for each changed ballot group
+//  in this shard.
+
+    for ( position = first_position ; position < last_position ; position ++ )
+    {
+        add_ballot_group_to_pairwise_counts( global_list_of_changed_ballot_groups[ position ] , global_ballot_count_change_for_changed_ballot_group[ position ] , pairwise_count_first_over_second ) ;
+    }
+
+
+// -----------------------------------------------
+//  End of function add_changed_ballot_groups_in_shard.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//        update_pairwise_counts
+//
+//  Updates the pairwise counts, which are kept
+//  from one counting cycle to the next, so that
+//  they match the remaining ballot counts of the
+//  ballot groups.  Only the ballot groups whose
+//  remaining ballot count has changed are added,
+//  and only the change is added.
+//
+//  Elected and eliminated candidates never become
+//  available again, and the pairwise counts are
+//  only used for available candidates, so the
+//  counts for pairs that include an elected or
+//  eliminated candidate are no longer updated.
+
+void update_pairwise_counts( )
+{
+
+    int candidate_number ;
+    int ballot_count_change ;
+    int count_of_changed_ballot_groups ;
+    int number_of_shards ;
+    int shard_number ;
+    long pointer_to_pairwise_count ;
+
+    std::vector< std::thread > tally_threads ;
+
+
+// -----------------------------------------------
+//  List the candidates whose pairwise counts are
+//  updated.
+
+    global_count_of_pairwise_counted_candidates = 0 ;
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        if ( global_true_or_false_available_candidate[ candidate_number ] == global_true )
+        {
+            global_count_of_pairwise_counted_candidates ++ ;
+            global_list_of_pairwise_counted_candidates[ global_count_of_pairwise_counted_candidates ] = candidate_number ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  The first time, create the pairwise counts
+//  with zero ballots counted in each ballot
+//  group, so that all the remaining ballots are
+//  added as changes.
+
+    if ( global_true_or_false_pairwise_counts_exist == global_false )
+    {
+        global_pairwise_count_first_over_second.assign( (size_t) global_length_of_ballot_group_row * global_length_of_ballot_group_row , 0 ) ;
+        global_ballot_count_in_pairwise_counts_for_ballot_group.assign( global_total_count_of_ballot_groups + 1 , 0 ) ;
+        global_total_ballot_count_in_pairwise_counts = 0 ;
+        global_true_or_false_pairwise_counts_exist = global_true ;
+    }
+
+
+// -----------------------------------------------
+//  List the ballot groups whose remaining ballot
+//  count has changed, along with the change, and
+//  update the ballot counts that are included in
+//  the pairwise counts.
+
+    global_list_of_changed_ballot_groups.clear( ) ;
+    global_ballot_count_change_for_changed_ballot_group.clear( ) ;
+    for ( global_ballot_group_pointer = 1 ; global_ballot_group_pointer <= global_total_count_of_ballot_groups ; global_ballot_group_pointer ++ )
+    {
+        ballot_count_change = global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] - global_ballot_count_in_pairwise_counts_for_ballot_group[ global_ballot_group_pointer ] ;
+        if ( ballot_count_change == 0 )
+        {
+            continue ;
+        }
+        global_list_of_changed_ballot_groups.push_back( global_ballot_group_pointer ) ;
+        global_ballot_count_change_for_changed_ballot_group.push_back( ballot_count_change ) ;
+        global_ballot_count_in_pairwise_counts_for_ballot_group[ global_ballot_group_pointer ] += ballot_count_change ;
+        global_total_ballot_count_in_pairwise_counts += ballot_count_change ;
+    }
+    count_of_changed_ballot_groups = (int) global_list_of_changed_ballot_groups.size( ) ;
+
+
+// -----------------------------------------------
+//  Split the changed ballot groups into shards,
+//  and add the changes for each shard in its own
+//  thread.  The last shard is handled in this
+//  thread.
+
+    number_of_shards = global_number_of_tally_threads ;
+    if ( number_of_shards > count_of_changed_ballot_groups )
+    {
+        number_of_shards = count_of_changed_ballot_groups ;
+    }
+    for ( shard_number = 0 ; shard_number < number_of_shards - 1 ; shard_number ++ )
+    {
+        tally_threads.push_back( std::thread( add_changed_ballot_groups_in_shard , shard_number , ( count_of_changed_ballot_groups * shard_number ) / number_of_shards , ( count_of_changed_ballot_groups * ( shard_number + 1 ) ) / number_of_shards , global_false ) ) ;
+    }
+    if ( number_of_shards > 0 )
+    {
+        add_changed_ballot_groups_in_shard( number_of_shards - 1 , ( count_of_changed_ballot_groups * ( number_of_shards - 1 ) ) / number_of_shards , count_of_changed_ballot_groups , global_true ) ;
+    }
+    for ( shard_number = 0 ; shard_number < (int) tally_threads.size( ) ; shard_number ++ )
+    {
+        tally_threads[ shard_number ].join( ) ;
+    }
+
+
+// -----------------------------------------------
+//  Add the other shards' pairwise counts, in
+//  shard order, to the pairwise counts.
+
+    for ( shard_number = 0 ; shard_number < number_of_shards - 1 ; shard_number ++ )
+    {
+        for ( pointer_to_pairwise_count = 0 ; pointer_to_pairwise_count < (long) global_pairwise_count_first_over_second.size( ) ; pointer_to_pairwise_count ++ )
+        {
+            global_pairwise_count_first_over_second[ pointer_to_pairwise_count ] += global_shard_pairwise_count_first_over_second[ shard_number ][ pointer_to_pairwise_count ] ;
+        }
+    }
+    if ( global_logging_info == global_true ) { log_out << "[pairwise counts updated for " << count_of_changed_ballot_groups << " ballot groups in " << number_of_shards << " shards]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  End of function update_pairwise_counts.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//        fill_pairwise_tally_table
+//
+//  This function fills the tally table with
+//  pairwise counts that apply to the candidates
+//  specified as still available to get elected.
+//
+//  When a candidate gets elected the ballot
+//  influence numbers change, so that changes the
+//  numbers in the tally table.  Those changes are
+//  added to the pairwise counts, which are kept
+//  between counting cycles, and then the tally
+//  table is filled from the pairwise counts.
+//  When a candidate is eliminated, the tally
+//  table no longer includes the pairs that
+//  include that candidate.
+
+void fill_pairwise_tally_table( )
+{
+
+    int pair_counter ;
+    int first_candidate_number ;
+    int second_candidate_number ;
+
+
+// -----------------------------------------------
+//  Log the number of pairs.
+
+    if ( global_logging_info == global_true ) { log_out << "[pair count is " << global_pair_counter_maximum << "]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  Bring the pairwise counts up to date.
+
+    update_pairwise_counts( ) ;
+
+
+// -----------------------------------------------
+//  Copy the pairwise counts into the tally table.
+//  The pair counter numbers already limit the
+//  pairs to the candidates who are still being
+//  considered.  Each remaining ballot that does
+//  not rank either candidate higher ranks them
+//  equally.
+
+    for ( pair_counter = 1 ; pair_counter <= global_pair_counter_maximum ; pair_counter ++ )
+    {
+        first_candidate_number = global_first_candidate_number_in_pair[ pair_counter ] ;
+        second_candidate_number = global_second_candidate_number_in_pair[ pair_counter ] ;
+        global_tally_first_over_second_in_pair[ pair_counter ] = global_pairwise_count_first_over_second[ ( first_candidate_number * global_length_of_ballot_group_row ) + second_candidate_number ] ;
+        global_tally_second_over_first_in_pair[ pair_counter ] = global_pairwise_count_first_over_second[ ( second_candidate_number * global_length_of_ballot_group_row ) + first_candidate_number ] ;
+        global_tally_first_equal_second_in_pair[ pair_counter ] = global_total_ballot_count_in_pairwise_counts - global_tally_first_over_second_in_pair[ pair_counter ] - global_tally_second_over_first_in_pair[ pair_counter ] ;
+    }
+
+
+// -----------------------------------------------
+//  End of function fill_pairwise_tally_table.
+
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//        check_for_pairwise_losing_candidate
+//
+//  This function looks for a pairwise losing
+//  candidate, and identifies that candidate if
+//  it exists.  It is impossible for there to be
+//  more than one pairwise losing candidate.
+
+int check_for_pairwise_losing_candidate( )
+{
+
+    int pair_counter ;
+    int candidate_number ;
+    int first_candidate_number ;
+    int second_candidate_number ;
+    int number_of_candidates_being_pairwise_considered ;
+
+
+// -----------------------------------------------
+//  Initialize the loss count numbers.  Also count
+//  how many candidates are being considered in
+//  this comparison, which can differ from the
+//  number of remaining candidates because
+//  pairwise comparisons are also used to break
+//  ties.
+
+    number_of_candidates_being_pairwise_considered = 0 ;
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        global_loss_count_for_candidate[ candidate_number ] = 0 ;
+        if ( global_true_or_false_pairwise_consider_candidate[ candidate_number ] == global_true )
+        {
+            number_of_candidates_being_pairwise_considered ++ ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  Count the number of pairwise losses for each
+//  candidate.
+
+    for ( pair_counter = 1 ; pair_counter <= global_pair_counter_maximum ; pair_counter ++ )
+    {
+        first_candidate_number = global_first_candidate_number_in_pair[ pair_counter ] ;
+        second_candidate_number = global_second_candidate_number_in_pair[ pair_counter ] ;
+        if ( global_tally_first_over_second_in_pair[ pair_counter ] > global_tally_second_over_first_in_pair[ pair_counter ] )
+        {
+            global_loss_count_for_candidate[ second_candidate_number ] ++ ;
+//            if ( global_logging_info == global_true ) { log_out << "[candidate " << second_candidate_number << " loses to candidate " << first_candidate_number << ", with " << global_tally_second_over_first_in_pair[ pair_counter ] << " votes versus " << global_tally_first_over_second_in_pair[ pair_counter ] << " votes]" << std::endl ; } ;
+        } else if ( global_tally_second_over_first_in_pair[ pair_counter ] > global_tally_first_over_second_in_pair[ pair_counter ] )
+        {
+            global_loss_count_for_candidate[ first_candidate_number ] ++ ;
+//            if ( global_logging_info == global_true ) { log_out << "[candidate " << first_candidate_number << " loses to candidate " << second_candidate_number << ", with " << global_tally_first_over_second_in_pair[ pair_counter ] << " votes versus " << global_tally_second_over_first_in_pair[ pair_counter ] << " votes]" << std::endl ; } ;
+        } else
+        {
+//            if ( global_logging_info == global_true ) { log_out << "[equal vote counts for candidate " << first_candidate_number << " and candidate " << second_candidate_number << ", both have " << global_tally_first_over_second_in_pair[ pair_counter ] << " votes]" << std::endl ; } ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  If there is a pairwise losing candidate,
+//  return with its candidate number.
+
+    if ( global_logging_info == global_true ) { log_out << "[pairwise comparing " << number_of_candidates_being_pairwise_considered << " candidates]" << std::endl ; } ;
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        if ( global_true_or_false_pairwise_consider_candidate[ candidate_number ] == global_true )
+        {
+            if ( global_loss_count_for_candidate[ candidate_number ] > 0 )
+            {
+//                if ( global_logging_info == global_true ) { log_out << "[loss count for candidate " << candidate_number << " is " << global_loss_count_for_candidate[ candidate_number ] << "]" << std::endl ; } ;
+                if ( global_loss_count_for_candidate[ candidate_number ] == ( number_of_candidates_being_pairwise_considered - 1 ) )
+                {
+                    if ( global_logging_info == global_true ) { log_out << "[found pairwise losing candidate, candidate " << candidate_number << "]" << std::endl ; } ;
+                    return candidate_number ;
+                }
+            }
+        }
+    }
+
+
+// -----------------------------------------------
+//  There was not pairwise losing candidate, so
+//  return with zero in what otherwise would be
+//  the candidate number.
+
+    if ( global_logging_info == global_true ) { log_out << "[did not find pairwise losing candidate]" << std::endl ; } ;
+    return 0 ;
+
+
+// -----------------------------------------------
+//  End of function check_for_pairwise_losing_candidate.
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//   find_top_ranked_candidates_in_ballot_group
+//
+//  Starting at the ballot group's current top
+//  position, finds the highest preference level
+//  that has at least one remaining candidate, and
+//  counts the remaining candidates at that level.
+//  Each of those candidates gets this ballot
+//  group added to its list of ballot groups in
+//  which it is top-ranked.
+
+void find_top_ranked_candidates_in_ballot_group( int ballot_group_number )
+{
+
+    int position ;
+    int candidate_number ;
+    int preference_level ;
+    int count_of_top_ranked_candidates ;
+    int top_ranked_candidate ;
+    long pointer_to_row ;
+
+
+// -----------------------------------------------
+//  Begin a loop that handles each preference
+//  level, starting at the current top position.
+//  Stop at the first preference level that has
+//  any remaining candidates.
+
+    pointer_to_row = (long) ballot_group_number * global_length_of_ballot_group_row ;
+    position = global_top_position_for_ballot_group[ ballot_group_number ] ;
+    count_of_top_ranked_candidates = 0 ;
+    top_ranked_candidate = 0 ;
+    while ( ( position <= global_number_of_candidates ) && ( count_of_top_ranked_candidates == 0 ) )
+    {
+        preference_level = global_preference_level_in_ballot_group_table[ pointer_to_row + global_candidate_in_ballot_group_order[ pointer_to_row + position ] ] ;
+        global_top_position_for_ballot_group[ ballot_group_number ] = position ;
+        global_top_preference_level_for_ballot_group[ ballot_group_number ] = preference_level ;
+
+
+// -----------------------------------------------
+//  Handle each candidate at this preference
 //  level.
 
-        if ( global_current_voteinfo_number > 0 )
+        while ( position <= global_number_of_candidates )
         {
-            candidate_number = global_current_voteinfo_number ;
-            global_ballot_preference_for_candidate[ candidate_number ] = preference_level ;
-            text_ballot_info += " " + convert_integer_to_text( candidate_number ) ;
-            preference_level ++ ;
+            candidate_number = global_candidate_in_ballot_group_order[ pointer_to_row + position ] ;
+            if ( global_preference_level_in_ballot_group_table[ pointer_to_row + candidate_number ] != preference_level )
+            {
+                break ;
+            }
+            if ( global_true_or_false_tracked_candidate[ candidate_number ] == global_true )
+            {
+                count_of_top_ranked_candidates ++ ;
+                top_ranked_candidate = candidate_number ;
+                global_ballot_groups_top_ranking_candidate[ candidate_number ].push_back( ballot_group_number ) ;
+            }
+            position ++ ;
         }
 
 
 // -----------------------------------------------
-//  Repeat the loop to handle the next
-//  voteinfo number.
+//  Repeat the loop for the next preference level.
 
-        global_pointer_to_voteinfo_number ++ ;
     }
 
 
 // -----------------------------------------------
-//  Log the current ballot count and candidate
-//  ranking sequence.
+//  Save the count of top-ranked candidates, and
+//  save the top-ranked candidate number if there
+//  is just one, otherwise zero.
 
-    if ( global_logging_info == global_true ) { log_out << "[group " << global_ballot_group_pointer << " bc " << global_ballot_info_repeat_count << " r " << global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] << " " << text_ballot_info << "]" << std::endl ; } ;
+    global_count_of_top_ranked_for_ballot_group[ ballot_group_number ] = count_of_top_ranked_candidates ;
+    if ( count_of_top_ranked_candidates == 1 )
+    {
+        global_top_ranked_candidate_for_ballot_group[ ballot_group_number ] = top_ranked_candidate ;
+    } else
+    {
+        global_top_ranked_candidate_for_ballot_group[ ballot_group_number ] = 0 ;
+    }
 
 
 // -----------------------------------------------
-//  Return with the number of ballot counts
-//  handled.  If zero, there are no more ballots.
+//  End of function find_top_ranked_candidates_in_ballot_group.
 
-    return global_ballot_info_repeat_count ;
-
-
-// -----------------------------------------------
-//  End of function get_candidate_ranks_from_one_ballot_group.
+    return ;
 
 }
 
 
 // -----------------------------------------------
 // -----------------------------------------------
-//          reset_tally_table
+//   initialize_top_ranked_tracking
 //
-//  Create and initialize the tally table.
-
-void reset_tally_table( )
+//  Puts each ballot group's candidate numbers in
+//  preference order, then identifies the
+//  top-ranked candidates in each ballot group.
+//  Every candidate is tracked as remaining at
+//  this point.  Candidates that are no longer
+//  available are removed during the first
+//  counting cycle.
+
+void initialize_top_ranked_tracking( )
 {
 
-    int pair_counter ;
-    int first_candidate_number ;
-    int second_candidate_number ;
+    int ballot_group_number ;
+    int candidate_number ;
+    int position ;
+    int sorted_position ;
+    int count_of_candidates_in_order ;
+    long pointer_to_row ;
 
 
 // -----------------------------------------------
-//  Create the pairwise candidate counters.  If
-//  the storage limit is exceeded, indicate this
-//  by putting zero into the value
-//  global_pair_counter_maximum.
+//  Create the tracking lists.
 
-    pair_counter = 0 ;
-    global_pair_counter_maximum = 0 ;
-    for ( first_candidate_number = 1 ; first_candidate_number < global_number_of_candidates ; first_candidate_number ++ )
+    global_top_position_for_ballot_group.assign( global_total_count_of_ballot_groups + 1 , 1 ) ;
+    global_top_preference_level_for_ballot_group.assign( global_total_count_of_ballot_groups + 1 , 0 ) ;
+    global_count_of_top_ranked_for_ballot_group.assign( global_total_count_of_ballot_groups + 1 , 0 ) ;
+    global_ballot_groups_top_ranking_candidate.assign( global_number_of_candidates + 1 , std::vector< int >( ) ) ;
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
     {
-        if ( global_true_or_false_pairwise_consider_candidate[ first_candidate_number ] == global_true )
+        global_true_or_false_tracked_candidate[ candidate_number ] = global_true ;
+    }
+
+
+// -----------------------------------------------
+//  Begin a loop that handles each ballot group.
+
+    for ( ballot_group_number = 1 ; ballot_group_number <= global_total_count_of_ballot_groups ; ballot_group_number ++ )
+    {
+        pointer_to_row = (long) ballot_group_number * global_length_of_ballot_group_row ;
+
+
+// -----------------------------------------------
+//  The candidate numbers were saved in ballot
+//  sequence, which normally is already in
+//  preference order.  Sort them by preference
+//  level, keeping the ballot sequence within each
+//  level.  Because they are almost always already
+//  in order, a simple insertion sort is fast.
+
+        count_of_candidates_in_order = 0 ;
+        while ( ( count_of_candidates_in_order < global_number_of_candidates ) && ( global_candidate_in_ballot_group_order[ pointer_to_row + count_of_candidates_in_order + 1 ] > 0 ) )
         {
-            for ( second_candidate_number = first_candidate_number + 1 ; second_candidate_number <= global_number_of_candidates ; second_candidate_number ++ )
+            count_of_candidates_in_order ++ ;
+        }
+        for ( position = 2 ; position <= count_of_candidates_in_order ; position ++ )
+        {
+            candidate_number = global_candidate_in_ballot_group_order[ pointer_to_row + position ] ;
+            sorted_position = position ;
+            while ( ( sorted_position > 1 ) && ( global_preference_level_in_ballot_group_table[ pointer_to_row + global_candidate_in_ballot_group_order[ pointer_to_row + sorted_position - 1 ] ] > global_preference_level_in_ballot_group_table[ pointer_to_row + candidate_number ] ) )
             {
-                if ( global_true_or_false_pairwise_consider_candidate[ second_candidate_number ] == global_true )
-                {
-                    pair_counter ++ ;
-                    global_pair_counter_maximum ++ ;
-                    if ( global_pair_counter_maximum >= global_maximum_candidate_pairs )
-                    {
-                        global_pair_counter_maximum = 0 ;
-                        if ( global_logging_info == global_true ) { log_out << "[error, the number of candidates being pairwise counted exceeds the available storage space]" ; } ;
-                        return ;
-                    }
-                    global_first_candidate_number_in_pair[ pair_counter ] = first_candidate_number ;
-                    global_second_candidate_number_in_pair[ pair_counter ] = second_candidate_number ;
-                }
+                global_candidate_in_ballot_group_order[ pointer_to_row + sorted_position ] = global_candidate_in_ballot_group_order[ pointer_to_row + sorted_position - 1 ] ;
+                sorted_position -- ;
             }
+            global_candidate_in_ballot_group_order[ pointer_to_row + sorted_position ] = candidate_number ;
         }
-    }
 
 
 // -----------------------------------------------
-//  If there were no candidates to pairwise
-//  compare, return with zero in the variable
-//  global_pair_counter_maximum.
+//  Put any candidates that do not appear on the
+//  ballot at the end, where they have the lowest
+//  preference level.
 
-    if ( global_pair_counter_maximum == 0 )
-    {
-        return ;
-    }
+        for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+        {
+            if ( ( global_preference_level_in_ballot_group_table[ pointer_to_row + candidate_number ] == 200 ) && ( count_of_candidates_in_order < global_number_of_candidates ) )
+            {
+                count_of_candidates_in_order ++ ;
+                global_candidate_in_ballot_group_order[ pointer_to_row + count_of_candidates_in_order ] = candidate_number ;
+            }
+        }
 
 
 // -----------------------------------------------
-//  Create, and clear, the tally table.
+//  Identify the top-ranked candidates.
+
+        find_top_ranked_candidates_in_ballot_group( ballot_group_number ) ;
+
+
+// -----------------------------------------------
+//  Repeat the loop for the next ballot group.
 
-    for ( pair_counter = 1 ; pair_counter <= global_pair_counter_maximum ; pair_counter ++ )
-    {
-        global_tally_first_over_second_in_pair[ pair_counter ] = 0 ;
-        global_tally_second_over_first_in_pair[ pair_counter ] = 0 ;
-        global_tally_first_equal_second_in_pair[ pair_counter ] = 0 ;
     }
 
 
 // -----------------------------------------------
-//  End of function reset_tally_table.
+//  End of function initialize_top_ranked_tracking.
 
     return ;
 
@@ -1699,105 +3214,121 @@ void reset_tally_table( )
 
 // -----------------------------------------------
 // -----------------------------------------------
-//        fill_pairwise_tally_table
-//
-//  This function fills the tally table with
-//  pairwise counts that apply to the candidates
-//  specified as still available to get elected.
+//   remove_candidate_from_top_ranked_tracking
 //
-//  When a candidate gets elected the ballot
-//  influence numbers change, so that changes the
-//  numbers in the tally table.  When a candidate
-//  is eliminated, a new tally table must be
-//  created and filled because one of the
-//  candidates is no longer among the pairs being
-//  tallied.
+//  Removes an elected or eliminated candidate
+//  from the tracking of top-ranked candidates.
+//  Only the ballot groups in which this candidate
+//  is top-ranked are updated.  In those ballot
+//  groups, if other candidates remain at the same
+//  preference level, they are still top-ranked,
+//  otherwise the top position moves down to the
+//  next preference level that has any remaining
+//  candidates.
 
-void fill_pairwise_tally_table( )
+void remove_candidate_from_top_ranked_tracking( int removed_candidate_number )
 {
 
-    int pair_counter ;
+    int pointer_to_list ;
+    int ballot_group_number ;
+    int position ;
     int candidate_number ;
-    int first_candidate_number ;
-    int second_candidate_number ;
-    int remaining_ballot_count_for_current_ballot_group ;
+    long pointer_to_row ;
 
 
 // -----------------------------------------------
-//  Log the number of pairs.
+//  Indicate that this candidate is no longer
+//  being tracked.
 
-    if ( global_logging_info == global_true ) { log_out << "[pair count is " << global_pair_counter_maximum << "]" << std::endl ; } ;
+    global_true_or_false_tracked_candidate[ removed_candidate_number ] = global_false ;
 
 
 // -----------------------------------------------
-//  Begin a loop that handles each ballot group.
+//  Begin a loop that handles each ballot group in
+//  which the removed candidate is top-ranked.
 
-    global_pointer_to_voteinfo_number = 1 ;
-    for ( global_ballot_group_pointer = 1 ; global_ballot_group_pointer <= global_total_count_of_ballot_groups ; global_ballot_group_pointer ++ )
+    for ( pointer_to_list = 0 ; pointer_to_list < (int) global_ballot_groups_top_ranking_candidate[ removed_candidate_number ].size( ) ; pointer_to_list ++ )
     {
+        ballot_group_number = global_ballot_groups_top_ranking_candidate[ removed_candidate_number ][ pointer_to_list ] ;
+        global_count_of_top_ranked_for_ballot_group[ ballot_group_number ] -- ;
 
 
 // -----------------------------------------------
-//  Get the number of remaining ballots in this
-//  ballot group that still have full influence.
+//  If no top-ranked candidates remain at this
+//  preference level, find the next preference
+//  level that has any remaining candidates.
 
-        remaining_ballot_count_for_current_ballot_group = global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] ;
-//        if ( global_logging_info == global_true ) { log_out << "[ballot group " << global_ballot_group_pointer << " has " << remaining_ballot_count_for_current_ballot_group << " ballots]" << std::endl ; } ;
+        if ( global_count_of_top_ranked_for_ballot_group[ ballot_group_number ] < 1 )
+        {
+            find_top_ranked_candidates_in_ballot_group( ballot_group_number ) ;
 
 
 // -----------------------------------------------
-//  If none of the ballots in this ballot group
-//  have their full influence, restart the loop to
-//  handle the next ballot group.
+//  If just one top-ranked candidate remains at
+//  this preference level, identify it.
 
-        if ( remaining_ballot_count_for_current_ballot_group < 1 )
+        } else if ( global_count_of_top_ranked_for_ballot_group[ ballot_group_number ] == 1 )
         {
-            log_out << "[all ballots in ballot group " << global_ballot_group_pointer << " have no more influence]" << std::endl ;
-            continue ;
+            pointer_to_row = (long) ballot_group_number * global_length_of_ballot_group_row ;
+            for ( position = global_top_position_for_ballot_group[ ballot_group_number ] ; position <= global_number_of_candidates ; position ++ )
+            {
+                candidate_number = global_candidate_in_ballot_group_order[ pointer_to_row + position ] ;
+                if ( global_true_or_false_tracked_candidate[ candidate_number ] == global_true )
+                {
+                    global_top_ranked_candidate_for_ballot_group[ ballot_group_number ] = candidate_number ;
+                    break ;
+                }
+            }
         }
 
 
 // -----------------------------------------------
-//  Get the preferences on the ballots in this
-//  group of identical ballots.
+//  Repeat the loop for the next ballot group.
 
-        global_ballot_info_repeat_count = get_candidate_ranks_from_one_ballot_group( ) ;
+    }
 
 
 // -----------------------------------------------
-//  For the current ballot pattern, add the
-//  pairwise counts to the tally table.  The pair
-//  counter numbers already limit the pairs to the
-//  candidates who are still being considered.
-//  Reminder: The preference level numbers are
-//  smallest for the highest-ranked candidates.
+//  The removed candidate's list of ballot groups
+//  is no longer needed, so release its storage
+//  space.
 
-        for ( pair_counter = 1 ; pair_counter <= global_pair_counter_maximum ; pair_counter ++ )
-        {
-            first_candidate_number = global_first_candidate_number_in_pair[ pair_counter ] ;
-            second_candidate_number = global_second_candidate_number_in_pair[ pair_counter ] ;
-            if ( global_ballot_preference_for_candidate[ first_candidate_number ] < global_ballot_preference_for_candidate[ second_candidate_number ] )
-            {
-                global_tally_first_over_second_in_pair[ pair_counter ] += remaining_ballot_count_for_current_ballot_group ;
-            } else if ( global_ballot_preference_for_candidate[ first_candidate_number ] > global_ballot_preference_for_candidate[ second_candidate_number ] )
-            {
-                global_tally_second_over_first_in_pair[ pair_counter ] += remaining_ballot_count_for_current_ballot_group ;
-            } else
-            {
-                global_tally_first_equal_second_in_pair[ pair_counter ] += remaining_ballot_count_for_current_ballot_group ;
-            }
-        }
+    std::vector< int >( ).swap( global_ballot_groups_top_ranking_candidate[ removed_candidate_number ] ) ;
+
+
+// -----------------------------------------------
+//  End of function remove_candidate_from_top_ranked_tracking.
+
+    return ;
+
+}
 
 
 // -----------------------------------------------
-//  Repeat the loop that gets info from each group
-//  of identical ballots.
+// -----------------------------------------------
+//   update_top_ranked_tracking
+//
+//  Removes from the tracking of top-ranked
+//  candidates each candidate who has been elected
+//  or eliminated since the previous update.
+
+void update_top_ranked_tracking( )
+{
+
+    int candidate_number ;
 
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        if ( ( global_true_or_false_tracked_candidate[ candidate_number ] == global_true ) && ( global_true_or_false_available_candidate[ candidate_number ] != global_true ) )
+        {
+            if ( global_logging_info == global_true ) { log_out << "[updating top-ranked candidates in " << global_ballot_groups_top_ranking_candidate[ candidate_number ].size( ) << " ballot groups that top-rank candidate " << candidate_number << "]" << std::endl ; } ;
+            remove_candidate_from_top_ranked_tracking( candidate_number ) ;
+        }
     }
 
 
 // -----------------------------------------------
-//  End of function fill_pairwise_tally_table.
+//  End of function update_top_ranked_tracking.
 
     return ;
 
@@ -1806,190 +3337,197 @@ void fill_pairwise_tally_table( )
 
 // -----------------------------------------------
 // -----------------------------------------------
-//        check_for_pairwise_losing_candidate
+//   identify_top_ranked_candidates
 //
-//  This function looks for a pairwise losing
-//  candidate, and identifies that candidate if
-//  it exists.  It is impossible for there to be
-//  more than one pairwise losing candidate.
+//  Identify which candidate is, or which
+//  candidates are, ranked at the top of the
+//  identical ballots in the current ballot
+//  group.  Already-elected and already-eliminated
+//  candidates are ignored.  The top-ranked
+//  candidates are already being tracked, so this
+//  just lists them, in candidate-number order.
 
-int check_for_pairwise_losing_candidate( )
+void identify_top_ranked_candidates( )
 {
 
-    int pair_counter ;
+    int position ;
     int candidate_number ;
-    int first_candidate_number ;
-    int second_candidate_number ;
-    int number_of_candidates_being_pairwise_considered ;
+    int sorted_position ;
+    int top_preference_level ;
 
 
 // -----------------------------------------------
-//  Initialize the loss count numbers.  Also count
-//  how many candidates are being considered in
-//  this comparison, which can differ from the
-//  number of remaining candidates because
-//  pairwise comparisons are also used to break
-//  ties.
+//  If there is just one top-ranked candidate, it
+//  is already known.
 
-    number_of_candidates_being_pairwise_considered = 0 ;
-    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    global_count_of_top_ranked_remaining_candidates = global_count_of_top_ranked_for_ballot_group[ global_ballot_group_pointer ] ;
+    if ( global_count_of_top_ranked_remaining_candidates == 1 )
     {
-        global_loss_count_for_candidate[ candidate_number ] = 0 ;
-        if ( global_true_or_false_pairwise_consider_candidate[ candidate_number ] == global_true )
-        {
-            number_of_candidates_being_pairwise_considered ++ ;
-        }
+        global_list_of_top_ranked_candidates[ 1 ] = global_top_ranked_candidate_for_ballot_group[ global_ballot_group_pointer ] ;
+        return ;
     }
 
 
 // -----------------------------------------------
-//  Count the number of pairwise losses for each
-//  candidate.
+//  List the remaining candidates at the top
+//  preference level, in candidate-number order.
+//
+//  Reminder: Ranking level 1 is the highest
+//  ranking level, and ranking levels with higher
+//  numbers are lower-ranked.
 
-    for ( pair_counter = 1 ; pair_counter <= global_pair_counter_maximum ; pair_counter ++ )
+    global_count_of_top_ranked_remaining_candidates = 0 ;
+    top_preference_level = global_top_preference_level_for_ballot_group[ global_ballot_group_pointer ] ;
+    for ( position = global_top_position_for_ballot_group[ global_ballot_group_pointer ] ; position <= global_number_of_candidates ; position ++ )
     {
-        first_candidate_number = global_first_candidate_number_in_pair[ pair_counter ] ;
-        second_candidate_number = global_second_candidate_number_in_pair[ pair_counter ] ;
-        if ( global_tally_first_over_second_in_pair[ pair_counter ] > global_tally_second_over_first_in_pair[ pair_counter ] )
-        {
-            global_loss_count_for_candidate[ second_candidate_number ] ++ ;
-//            if ( global_logging_info == global_true ) { log_out << "[candidate " << second_candidate_number << " loses to candidate " << first_candidate_number << ", with " << global_tally_second_over_first_in_pair[ pair_counter ] << " votes versus " << global_tally_first_over_second_in_pair[ pair_counter ] << " votes]" << std::endl ; } ;
-        } else if ( global_tally_second_over_first_in_pair[ pair_counter ] > global_tally_first_over_second_in_pair[ pair_counter ] )
+        candidate_number = global_candidate_in_ballot_group_order[ global_pointer_to_ballot_group_row + position ] ;
+        if ( global_preference_level_in_ballot_group_table[ global_pointer_to_ballot_group_row + candidate_number ] != top_preference_level )
         {
-            global_loss_count_for_candidate[ first_candidate_number ] ++ ;
-//            if ( global_logging_info == global_true ) { log_out << "[candidate " << first_candidate_number << " loses to candidate " << second_candidate_number << ", with " << global_tally_first_over_second_in_pair[ pair_counter ] << " votes versus " << global_tally_second_over_first_in_pair[ pair_counter ] << " votes]" << std::endl ; } ;
-        } else
+            break ;
+        }
+        if ( global_true_or_false_tracked_candidate[ candidate_number ] == global_true )
         {
-//            if ( global_logging_info == global_true ) { log_out << "[equal vote counts for candidate " << first_candidate_number << " and candidate " << second_candidate_number << ", both have " << global_tally_first_over_second_in_pair[ pair_counter ] << " votes]" << std::endl ; } ;
+            global_count_of_top_ranked_remaining_candidates ++ ;
+            sorted_position = global_count_of_top_ranked_remaining_candidates ;
+            while ( ( sorted_position > 1 ) && ( global_list_of_top_ranked_candidates[ sorted_position - 1 ] > candidate_number ) )
+            {
+                global_list_of_top_ranked_candidates[ sorted_position ] = global_list_of_top_ranked_candidates[ sorted_position - 1 ] ;
+                sorted_position -- ;
+            }
+            global_list_of_top_ranked_candidates[ sorted_position ] = candidate_number ;
         }
     }
 
 
 // -----------------------------------------------
-//  If there is a pairwise losing candidate,
-//  return with its candidate number.
+//  End of function identify_top_ranked_candidates.
 
-    if ( global_logging_info == global_true ) { log_out << "[pairwise comparing " << number_of_candidates_being_pairwise_considered << " candidates]" << std::endl ; } ;
-    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
-    {
-        if ( global_true_or_false_pairwise_consider_candidate[ candidate_number ] == global_true )
-        {
-            if ( global_loss_count_for_candidate[ candidate_number ] > 0 )
-            {
-//                if ( global_logging_info == global_true ) { log_out << "[loss count for candidate " << candidate_number << " is " << global_loss_count_for_candidate[ candidate_number ] << "]" << std::endl ; } ;
-                if ( global_loss_count_for_candidate[ candidate_number ] == ( number_of_candidates_being_pairwise_considered - 1 ) )
-                {
-                    if ( global_logging_info == global_true ) { log_out << "[found pairwise losing candidate, candidate " << candidate_number << "]" << std::endl ; } ;
-                    return candidate_number ;
-                }
-            }
+    return ;
+
+}
+
+
+// -----------------------------------------------
+// -----------------------------------------------
+//   clear_pattern_table
+//
+//  Clears the list of ballot patterns at the
+//  start of a counting cycle.  Only the hash
+//  slots that were used are cleared.
+
+void clear_pattern_table( )
+{
+
+    int pattern_number_pointer ;
+
+
+// -----------------------------------------------
+//  If the hash table has not been created yet,
+//  create it.  Otherwise empty the hash slots
+//  that are used.
+
+    if ( global_pattern_number_pointer_in_hash_slot.size( ) == 0 )
+    {
+        global_pattern_number_pointer_in_hash_slot.assign( global_initial_pattern_hash_slot_count , 0 ) ;
+    } else
+    {
+        for ( pattern_number_pointer = 1 ; pattern_number_pointer <= global_count_of_unique_pattern_numbers ; pattern_number_pointer ++ )
+        {
+            global_pattern_number_pointer_in_hash_slot[ global_hash_slot_for_pattern_number_pointer[ pattern_number_pointer ] ] = 0 ;
         }
     }
 
 
 // -----------------------------------------------
-//  There was not pairwise losing candidate, so
-//  return with zero in what otherwise would be
-//  the candidate number.
+//  Empty the lists, except for the unused
+//  position zero.
 
-    if ( global_logging_info == global_true ) { log_out << "[did not find pairwise losing candidate]" << std::endl ; } ;
-    return 0 ;
+    global_count_of_unique_pattern_numbers = 0 ;
+    global_bits_for_pattern_number_pointer.assign( global_pattern_words_per_pattern , 0 ) ;
+    global_ballot_count_for_pattern_number_pointer.assign( 1 , 0 ) ;
+    global_top_candidate_count_for_pattern_number_pointer.assign( 1 , 0 ) ;
+    global_start_of_candidates_for_pattern_number_pointer.assign( 1 , 0 ) ;
+    global_hash_slot_for_pattern_number_pointer.assign( 1 , 0 ) ;
+    global_candidates_for_patterns.clear( ) ;
 
 
 // -----------------------------------------------
-//  End of function check_for_pairwise_losing_candidate.
+//  End of function clear_pattern_table.
+
+    return ;
 
 }
 
 
 // -----------------------------------------------
 // -----------------------------------------------
-//   identify_top_ranked_candidates
+//   get_hash_slot_for_pattern_bits
 //
-//  Identify which candidate is, or which
-//  candidates are, ranked at the top of the
-//  identical ballots in the current ballot
-//  group.  Already-elected and already-eliminated
-//  candidates are ignored.
+//  Calculates which hash slot is where the search
+//  for the supplied pattern bits begins.
 
-void identify_top_ranked_candidates( )
+int get_hash_slot_for_pattern_bits( const unsigned long long * pattern_bits )
 {
 
-    int candidate_number ;
-    int top_ranked_candidate_if_only_one_else_zero ;
-    int highest_preference_level_of_any_remaining_candidate ;
-    int pointer_to_list_of_candidates_with_highest_transfer_count ;
-
-
-// -----------------------------------------------
-//  Initialization.
+    int word_number ;
+    unsigned long long hash_value ;
 
-    top_ranked_candidate_if_only_one_else_zero = 0 ;
-    global_count_of_top_ranked_remaining_candidates = 0 ;
-    highest_preference_level_of_any_remaining_candidate = 0 ;
+    hash_value = 0 ;
+    for ( word_number = 0 ; word_number < global_pattern_words_per_pattern ; word_number ++ )
+    {
+        hash_value = ( hash_value ^ pattern_bits[ word_number ] ) * 0x9E3779B97F4A7C15ULL ;
+    }
+    return (int) ( ( hash_value >> 32 ) & (unsigned long long) ( global_pattern_number_pointer_in_hash_slot.size( ) - 1 ) ) ;
 
 
 // -----------------------------------------------
-//  Begin a loop that handles each candidate who
-//  is still available to win a seat.
+//  End of function get_hash_slot_for_pattern_bits.
 
-    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
-    {
-        global_true_or_false_is_top_ranked_candidate[ candidate_number ] = global_false ;
-        if ( global_true_or_false_available_candidate[ candidate_number ] == global_true )
-        {
+}
 
 
 // -----------------------------------------------
-//  Identify which candidates are top ranked.
-//  Save the top ranked candidate number for cases
-//  in which there is just one top-ranked
-//  candidate, and save the list of top-ranked
-//  candidates for cases in which there are
-//  multiple candidates.
+// -----------------------------------------------
+//   enlarge_pattern_hash_table
 //
-//  Reminder: Ranking level 1 is the highest
-//  ranking level, and ranking levels with higher
-//  numbers are lower-ranked.
+//  Doubles the number of hash slots, and puts
+//  every pattern into its slot in the larger
+//  hash table.
 
-            if ( ( highest_preference_level_of_any_remaining_candidate == 0 ) || ( global_ballot_preference_for_candidate[ candidate_number ] < highest_preference_level_of_any_remaining_candidate  ) )
-            {
-                highest_preference_level_of_any_remaining_candidate = global_ballot_preference_for_candidate[ candidate_number ] ;
-                global_count_of_top_ranked_remaining_candidates = 1 ;
-                global_list_of_top_ranked_candidates[ global_count_of_top_ranked_remaining_candidates ] = candidate_number ;
-                global_top_ranked_candidate_for_ballot_group[ global_ballot_group_pointer ] = candidate_number ;
-                top_ranked_candidate_if_only_one_else_zero = candidate_number ;
-            } else if ( global_ballot_preference_for_candidate[ candidate_number ] == highest_preference_level_of_any_remaining_candidate  )
-            {
-                global_count_of_top_ranked_remaining_candidates ++ ;
-                global_list_of_top_ranked_candidates[ global_count_of_top_ranked_remaining_candidates ] = candidate_number ;
-                top_ranked_candidate_if_only_one_else_zero = 0 ;
-                global_top_ranked_candidate_for_ballot_group[ global_ballot_group_pointer ] = 0 ;
-            }
+void enlarge_pattern_hash_table( )
+{
+
+    int pattern_number_pointer ;
+    int hash_slot ;
 
 
 // -----------------------------------------------
-//  Repeat the loop for the next available
-//  candidate.
+//  Create the larger, empty, hash table.
 
-        }
-    }
+    global_pattern_number_pointer_in_hash_slot.assign( global_pattern_number_pointer_in_hash_slot.size( ) * 2 , 0 ) ;
 
 
 // -----------------------------------------------
-//  Create flags that indicate whether each
-//  candidate is one of the top-ranked candidates.
+//  Put each pattern into the first empty slot at
+//  or after its hash slot.
 
-    for ( pointer_to_list_of_candidates_with_highest_transfer_count = 1 ; pointer_to_list_of_candidates_with_highest_transfer_count <= global_count_of_top_ranked_remaining_candidates ; pointer_to_list_of_candidates_with_highest_transfer_count ++ )
+    for ( pattern_number_pointer = 1 ; pattern_number_pointer <= global_count_of_unique_pattern_numbers ; pattern_number_pointer ++ )
     {
-        candidate_number = global_list_of_top_ranked_candidates[ pointer_to_list_of_candidates_with_highest_transfer_count ] ;
-        global_true_or_false_is_top_ranked_candidate[ candidate_number ] = global_true ;
-//        if ( global_logging_info == global_true ) { log_out << "[candidate " << candidate_number << " is top-ranked]" << std::endl ; } ;
+        hash_slot = get_hash_slot_for_pattern_bits( &global_bits_for_pattern_number_pointer[ pattern_number_pointer * global_pattern_words_per_pattern ] ) ;
+        while ( global_pattern_number_pointer_in_hash_slot[ hash_slot ] != 0 )
+        {
+            hash_slot = ( hash_slot + 1 ) & ( (int) global_pattern_number_pointer_in_hash_slot.size( ) - 1 ) ;
+        }
+        global_pattern_number_pointer_in_hash_slot[ hash_slot ] = pattern_number_pointer ;
+        global_hash_slot_for_pattern_number_pointer[ pattern_number_pointer ] = hash_slot ;
     }
+    if ( global_logging_info == global_true ) { log_out << "[pattern hash table enlarged to " << global_pattern_number_pointer_in_hash_slot.size( ) << " slots]" << std::endl ; } ;
 
 
 // -----------------------------------------------
-//  End of function identify_top_ranked_candidates.
+//  End of function enlarge_pattern_hash_table.
+
+    return ;
 
 }
 
@@ -2033,13 +3571,12 @@ void add_current_ballot_group_votes_to_vote_transfer_counts( )
 {
 
     int candidate_number ;
-    int pattern_number ;
+    int word_number ;
+    int hash_slot ;
     int pattern_number_pointer ;
-    int remaining_pattern_number ;
     int pointer_to_matching_pattern_number ;
-    int highest_preference_level_of_any_remaining_candidate ;
     int pointer_to_list_of_candidates_with_highest_transfer_count ;
-    int pointer_to_list_of_candidates_with_lowest_transfer_count ;
+    unsigned long long pattern_bits[ global_pattern_words_per_pattern ] ;
 
 
 // -----------------------------------------------
@@ -2061,21 +3598,6 @@ void add_current_ballot_group_votes_to_vote_transfer_counts( )
     identify_top_ranked_candidates( ) ;
 
 
-// -----------------------------------------------
-//  If there are too many top-ranked candidates,
-//  clear the count to zero.
-//
-//  The limit is 5 because 6 candidates will
-//  create a ballot pattern number that is an
-//  excessively large integer.
-
-    if ( global_count_of_top_ranked_remaining_candidates > 5 )
-    {
-        global_count_of_top_ranked_remaining_candidates = 0 ;
-        if ( global_logging_info == global_true ) { log_out << "[too many top-ranked candidates (" << global_count_of_top_ranked_remaining_candidates << ") in ballot group " << global_count_of_top_ranked_remaining_candidates << " so ignoring this ballot group during this counting cycle]" << std::endl ; } ;
-    }
-
-
 // -----------------------------------------------
 //  If this ballot marks more than one top-ranked
 //  candidate at the same ranking level, and if
@@ -2101,77 +3623,94 @@ void add_current_ballot_group_votes_to_vote_transfer_counts( )
 
 
 // -----------------------------------------------
-//  Calculate a pattern number that is unique for
-//  the combination of shared top ranked
-//  candidates.  If only one candidate is top
-//  ranked, the pattern number is simply the
-//  candidate number.  This pattern-number
-//  generation method accesses the candidate
-//  numbers in candidate-number sequence so that
-//  the same candidates (accessed in any order)
-//  yield the same pattern number.  If the pattern
-//  number is zero, exit with an error message.
+//  If there are no top-ranked candidates, exit
+//  with an error message.
 
-    pattern_number = 0 ;
-    if ( global_count_of_top_ranked_remaining_candidates > 0 )
+    if ( global_count_of_top_ranked_remaining_candidates < 1 )
     {
-        for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
-        {
-            if ( global_true_or_false_is_top_ranked_candidate[ candidate_number ] == global_true )
-            {
-                pattern_number = ( pattern_number * ( global_number_of_candidates + 1 ) ) + candidate_number ;
-            }
-        }
+        log_out << "[error, bug has been introduced into code, ballot group has no top-ranked candidates]" ;
+        std::cout << "[Error: Bug has been introduced into code, ballot group has no top-ranked candidates.]" << std::endl ;
+        exit( EXIT_FAILURE ) ;
     }
-    if ( pattern_number == 0 )
+
+
+// -----------------------------------------------
+//  Create the pattern bits that identify the
+//  combination of shared top ranked candidates,
+//  with one bit for each candidate number.  The
+//  same candidates (in any order) yield the same
+//  pattern bits, and any number of candidates can
+//  share the top ranking level.
+
+    for ( word_number = 0 ; word_number < global_pattern_words_per_pattern ; word_number ++ )
     {
-        log_out << "[error, bug has been introduced into code, pattern number is zero]" ;
-        std::cout << "[Error: Bug has been introduced into code, pattern number is zero.]" << std::endl ;
-        exit( EXIT_FAILURE ) ;
+        pattern_bits[ word_number ] = 0 ;
+    }
+    for ( pointer_to_list_of_candidates_with_highest_transfer_count = 1 ; pointer_to_list_of_candidates_with_highest_transfer_count <= global_count_of_top_ranked_remaining_candidates ; pointer_to_list_of_candidates_with_highest_transfer_count ++ )
+    {
+        candidate_number = global_list_of_top_ranked_candidates[ pointer_to_list_of_candidates_with_highest_transfer_count ] ;
+        pattern_bits[ candidate_number / global_pattern_bits_per_word ] |= 1ULL << ( candidate_number % global_pattern_bits_per_word ) ;
     }
 
 
 // -----------------------------------------------
-//  If this pattern number has been encountered
-//  previously, point to it. Otherwise set the
-//  pointer to zero.
+//  If this pattern has been encountered
+//  previously, point to it.  Otherwise set the
+//  pointer to zero, and leave the hash slot
+//  pointing to the empty slot where the pattern
+//  will be added.
 
     pointer_to_matching_pattern_number = 0 ;
-    if ( global_count_of_unique_pattern_numbers > 0 )
+    hash_slot = get_hash_slot_for_pattern_bits( pattern_bits ) ;
+    while ( global_pattern_number_pointer_in_hash_slot[ hash_slot ] != 0 )
     {
-        for ( pattern_number_pointer = 1 ; pattern_number_pointer <= global_count_of_unique_pattern_numbers ; pattern_number_pointer ++ )
+        pattern_number_pointer = global_pattern_number_pointer_in_hash_slot[ hash_slot ] ;
+        for ( word_number = 0 ; word_number < global_pattern_words_per_pattern ; word_number ++ )
         {
-            if ( pattern_number == global_pattern_number_for_pattern_number_pointer[ pattern_number_pointer ] )
+            if ( global_bits_for_pattern_number_pointer[ ( pattern_number_pointer * global_pattern_words_per_pattern ) + word_number ] != pattern_bits[ word_number ] )
             {
-                pointer_to_matching_pattern_number = pattern_number_pointer ;
                 break ;
             }
         }
+        if ( word_number == global_pattern_words_per_pattern )
+        {
+            pointer_to_matching_pattern_number = pattern_number_pointer ;
+            break ;
+        }
+        hash_slot = ( hash_slot + 1 ) & ( (int) global_pattern_number_pointer_in_hash_slot.size( ) - 1 ) ;
     }
 
 
 // -----------------------------------------------
 //  Keep track of how many ballots have the same
 //  candidates sharing the top/highest ranking
-//  level.
+//  level.  A new pattern also saves its list of
+//  candidate numbers.  If the hash table becomes
+//  half full, enlarge it.
 
     if ( pointer_to_matching_pattern_number > 0 )
     {
         global_ballot_count_for_pattern_number_pointer[ pointer_to_matching_pattern_number ] += global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] ;
     } else
     {
-        if ( global_count_of_unique_pattern_numbers < global_maximum_number_of_pattern_numbers )
+        global_count_of_unique_pattern_numbers ++ ;
+        pointer_to_matching_pattern_number = global_count_of_unique_pattern_numbers ;
+        for ( word_number = 0 ; word_number < global_pattern_words_per_pattern ; word_number ++ )
         {
-            global_count_of_unique_pattern_numbers ++ ;
-            pointer_to_matching_pattern_number = global_count_of_unique_pattern_numbers ;
-            global_pattern_number_for_pattern_number_pointer[ pointer_to_matching_pattern_number ] = pattern_number ;
-            global_ballot_count_for_pattern_number_pointer[ pointer_to_matching_pattern_number ] = global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] ;
-            global_top_candidate_count_for_pattern_number_pointer[ pointer_to_matching_pattern_number ] = global_count_of_top_ranked_remaining_candidates ;
-        } else
+            global_bits_for_pattern_number_pointer.push_back( pattern_bits[ word_number ] ) ;
+        }
+        global_ballot_count_for_pattern_number_pointer.push_back( global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] ) ;
+        global_top_candidate_count_for_pattern_number_pointer.push_back( global_count_of_top_ranked_remaining_candidates ) ;
+        global_start_of_candidates_for_pattern_number_pointer.push_back( (int) global_candidates_for_patterns.size( ) ) ;
+        for ( pointer_to_list_of_candidates_with_highest_transfer_count = 1 ; pointer_to_list_of_candidates_with_highest_transfer_count <= global_count_of_top_ranked_remaining_candidates ; pointer_to_list_of_candidates_with_highest_transfer_count ++ )
         {
-            log_out << "[error: there are too many unique patterns of ballot markings that rank multiple remaining candidates at the same preference level, so increase the length of the lists named global_pattern_number_for_pattern_number_pointer, global_ballot_count_for_pattern_number_pointer, and global_top_candidate_count_for_pattern_number_pointer, which currently have a length of " << global_maximum_number_of_pattern_numbers << "]" << std::endl ;
-            std::cout << "[Error: There are too many unique patterns of ballot markings that rank multiple remaining candidates at the same preference level, so increase the length of the lists named global_pattern_number_for_pattern_number_pointer, global_ballot_count_for_pattern_number_pointer, and global_top_candidate_count_for_pattern_number_pointer, which currently have a length of " << global_maximum_number_of_pattern_numbers << ".]" << std::endl ;
-            exit( EXIT_FAILURE ) ;
+            global_candidates_for_patterns.push_back( global_list_of_top_ranked_candidates[ pointer_to_list_of_candidates_with_highest_transfer_count ] ) ;
+        }
+        global_pattern_number_pointer_in_hash_slot[ hash_slot ] = pointer_to_matching_pattern_number ;
+        global_hash_slot_for_pattern_number_pointer.push_back( hash_slot ) ;
+        if ( ( global_count_of_unique_pattern_numbers * 2 ) > (int) global_pattern_number_pointer_in_hash_slot.size( ) )
+        {
+            enlarge_pattern_hash_table( ) ;
         }
     }
 
@@ -2184,6 +3723,116 @@ void add_current_ballot_group_votes_to_vote_transfer_counts( )
 }
 
 
+// -----------------------------------------------
+// -----------------------------------------------
+//        count_all_ballot_groups
+//
+//  Counts all the ballot groups for the current
+//  counting cycle.  The ballot groups are split
+//  into shards that are counted at the same time,
+//  one thread per shard, and then the shard
+//  results are combined in shard order.  The
+//  counts for candidates who are top-ranked alone
+//  are added together, and the shared ballot
+//  groups are added to the top-ranking patterns
+//  in ballot-group order, which is the same order
+//  as when only one thread is used.
+
+void count_all_ballot_groups( )
+{
+
+    int number_of_shards ;
+    int shard_number ;
+    int candidate_number ;
+    int pointer_to_shared_ballot_group ;
+    int count_of_shared_ballot_groups ;
+
+    std::vector< std::thread > tally_threads ;
+
+
+// -----------------------------------------------
+//  Split the ballot groups into shards, and count
+//  each shard in its own thread.  The last shard
+//  is counted in this thread.
+
+    number_of_shards = global_number_of_tally_threads ;
+    if ( number_of_shards > global_total_count_of_ballot_groups )
+    {
+        number_of_shards = global_total_count_of_ballot_groups ;
+    }
+    if ( number_of_shards < 1 )
+    {
+        number_of_shards = 1 ;
+    }
+    for ( shard_number = 0 ; shard_number < number_of_shards - 1 ; shard_number ++ )
+    {
+        tally_threads.push_back( std::thread( count_ballot_groups_in_shard , shard_number , 1 + ( global_total_count_of_ballot_groups * shard_number ) / number_of_shards , 1 + ( global_total_count_of_ballot_groups * ( shard_number + 1 ) ) / number_of_shards ) ) ;
+    }
+    count_ballot_groups_in_shard( number_of_shards - 1 , 1 + ( global_total_count_of_ballot_groups * ( number_of_shards - 1 ) ) / number_of_shards , 1 + global_total_count_of_ballot_groups ) ;
+    for ( shard_number = 0 ; shard_number < (int) tally_threads.size( ) ; shard_number ++ )
+    {
+        tally_threads[ shard_number ].join( ) ;
+    }
+
+
+// -----------------------------------------------
+//  Add the shard counts, in shard order, to the
+//  counts for the candidates who are top-ranked
+//  alone.
+
+    for ( candidate_number = 0 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        global_ballot_count_for_single_top_candidate[ candidate_number ] = 0 ;
+    }
+    for ( shard_number = 0 ; shard_number < number_of_shards ; shard_number ++ )
+    {
+        for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+        {
+            global_ballot_count_for_single_top_candidate[ candidate_number ] += global_shard_ballot_count_for_single_top_candidate[ shard_number ][ candidate_number ] ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  Add the shared ballot groups, in shard order,
+//  to the counters that apply to all the ballots
+//  that have the same available (remaining)
+//  candidates ranked above all the other
+//  available candidates.
+//
+//  For example, if candidates A and B have been
+//  elected or eliminated, and a ballot group
+//  ranks candidate A highest and ranks candidates
+//  B, C, and D at the next-highest level, and
+//  another ballot group ranks candidate B highest
+//  and ranks candidates A, C, and D at the
+//  next-highest level, then these two ballot
+//  groups are counted together, along with any
+//  other ballot groups that rank candidates C and
+//  D as the highest-ranked remaining candidates.
+
+    count_of_shared_ballot_groups = 0 ;
+    for ( shard_number = 0 ; shard_number < number_of_shards ; shard_number ++ )
+    {
+        for ( pointer_to_shared_ballot_group = 0 ; pointer_to_shared_ballot_group < (int) global_shard_list_of_shared_ballot_groups[ shard_number ].size( ) ; pointer_to_shared_ballot_group ++ )
+        {
+            global_ballot_group_pointer = global_shard_list_of_shared_ballot_groups[ shard_number ][ pointer_to_shared_ballot_group ] ;
+            global_pointer_to_ballot_group_row = (long) global_ballot_group_pointer * global_length_of_ballot_group_row ;
+            add_current_ballot_group_votes_to_vote_transfer_counts( ) ;
+            count_of_shared_ballot_groups ++ ;
+        }
+    }
+    if ( global_logging_info == global_true ) { log_out << "[counted " << global_total_count_of_ballot_groups << " ballot groups in " << number_of_shards << " shards, " << count_of_shared_ballot_groups << " with shared top ranking]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  End of function count_all_ballot_groups.
+
+    return ;
+
+}
+
+
 // -----------------------------------------------
 // -----------------------------------------------
 //  calculate_transfer_count_for_each_candidate
@@ -2204,9 +3853,9 @@ void calculate_transfer_count_for_each_candidate( )
 {
 
     int candidate_number ;
-    int pattern_number ;
-    int remaining_pattern_number ;
     int pattern_number_pointer ;
+    int start_of_candidates_for_pattern ;
+    int pointer_to_candidate_in_pattern ;
     int count_of_candidates_at_top_preference_level ;
     int ballot_count_for_shared_preference_level ;
     int count_of_votes_to_each_candidate_at_shared_preference_level ;
@@ -2221,6 +3870,23 @@ void calculate_transfer_count_for_each_candidate( )
     global_current_total_vote_count = 0 ;
 
 
+// -----------------------------------------------
+//  Transfer the ballots that rank just one
+//  remaining candidate at the top to that
+//  candidate.  The calculation is the same as for
+//  a pattern that has one candidate.
+
+    for ( candidate_number = 1 ; candidate_number <= global_number_of_candidates ; candidate_number ++ )
+    {
+        if ( global_ballot_count_for_single_top_candidate[ candidate_number ] > 0 )
+        {
+            count_of_votes_to_each_candidate_at_shared_preference_level = int( float( global_ballot_count_for_single_top_candidate[ candidate_number ] ) / float( 1 ) ) ;
+            global_vote_transfer_count_for_candidate[ candidate_number ] += count_of_votes_to_each_candidate_at_shared_preference_level ;
+            global_current_total_vote_count += count_of_votes_to_each_candidate_at_shared_preference_level ;
+        }
+    }
+
+
 // -----------------------------------------------
 //  Begin a loop that handles each pattern number.
 
@@ -2234,8 +3900,8 @@ void calculate_transfer_count_for_each_candidate( )
 //  preference level.
 
         ballot_count_for_shared_preference_level = global_ballot_count_for_pattern_number_pointer[ pattern_number_pointer ] ;
-        remaining_pattern_number = global_pattern_number_for_pattern_number_pointer[ pattern_number_pointer ] ;
         count_of_candidates_at_top_preference_level = global_top_candidate_count_for_pattern_number_pointer[ pattern_number_pointer ] ;
+        start_of_candidates_for_pattern = global_start_of_candidates_for_pattern_number_pointer[ pattern_number_pointer ] ;
 
 
 // -----------------------------------------------
@@ -2253,7 +3919,7 @@ void calculate_transfer_count_for_each_candidate( )
 
         if ( count_of_candidates_at_top_preference_level > 1 )
         {
-            if ( global_logging_info == global_true ) { log_out << "[check: pattern number " << remaining_pattern_number << ", shared pref count " << count_of_candidates_at_top_preference_level << ", ballot count " << ballot_count_for_shared_preference_level << ", each candidate gets " << count_of_votes_to_each_candidate_at_shared_preference_level << " votes]" << std::endl ; } ;
+            if ( global_logging_info == global_true ) { log_out << "[check: pattern number " << pattern_number_pointer << ", shared pref count " << count_of_candidates_at_top_preference_level << ", ballot count " << ballot_count_for_shared_preference_level << ", each candidate gets " << count_of_votes_to_each_candidate_at_shared_preference_level << " votes]" << std::endl ; } ;
         }
 
 
@@ -2264,14 +3930,10 @@ void calculate_transfer_count_for_each_candidate( )
 //  the transfer count that is used to elect
 //  candidates, and (when there are no pairwise
 //  losing candidates) eliminate candidates.
-//
-//  Reminder:  The "%" symbol requests "modulo"
-//  arithmetic.
 
-        while ( remaining_pattern_number > 0 )
+        for ( pointer_to_candidate_in_pattern = start_of_candidates_for_pattern ; pointer_to_candidate_in_pattern < start_of_candidates_for_pattern + count_of_candidates_at_top_preference_level ; pointer_to_candidate_in_pattern ++ )
         {
-            candidate_number = remaining_pattern_number % ( global_number_of_candidates + 1 ) ;
-            remaining_pattern_number = ( remaining_pattern_number - candidate_number ) / ( global_number_of_candidates + 1 ) ;
+            candidate_number = global_candidates_for_patterns[ pointer_to_candidate_in_pattern ] ;
             global_vote_transfer_count_for_candidate[ candidate_number ] += count_of_votes_to_each_candidate_at_shared_preference_level ;
             global_current_total_vote_count += count_of_votes_to_each_candidate_at_shared_preference_level ;
 //            if ( global_logging_info == global_true ) { log_out << "[candidate " << candidate_number << " gets " << count_of_votes_to_each_candidate_at_shared_preference_level << " votes]" << std::endl ; } ;
@@ -2413,7 +4075,6 @@ void adjust_for_quota_excess( )
 // -----------------------------------------------
 //  Begin a loop that handles each ballot group.
 
-    global_pointer_to_voteinfo_number = 1 ;
     for ( global_ballot_group_pointer = 1 ; global_ballot_group_pointer <= global_total_count_of_ballot_groups ; global_ballot_group_pointer ++ )
     {
 
@@ -2427,12 +4088,11 @@ void adjust_for_quota_excess( )
 
 // -----------------------------------------------
 //  If the ballot count for this ballot group has
-//  already reached zero votes, point to the next
-//  ballot group and restart the loop.
+//  already reached zero votes, restart the loop
+//  to handle the next ballot group.
 
         if ( remaining_ballot_count_for_current_ballot_group == 0 )
         {
-            point_to_next_ballot_group( ) ;
             continue ;
         }
 
@@ -2446,21 +4106,13 @@ void adjust_for_quota_excess( )
 
 
 // -----------------------------------------------
-//  If this ballot group has multiple top-ranked
-//  candidates, identify them.  In all cases,
-//  count how many candidates are top-ranked on
-//  these identical ballots.  Also point to the
-//  next ballot group.
+//  Get the count of how many candidates are
+//  top-ranked on these identical ballots.
+//  Reminder:  The top-ranked candidates are not
+//  updated until the next counting cycle, so they
+//  still include the just-elected candidate.
 
-        if ( top_ranked_candidate_if_only_one_else_zero == 0 )
-        {
-            global_ballot_info_repeat_count = get_candidate_ranks_from_one_ballot_group( ) ;
-            identify_top_ranked_candidates( ) ;
-        } else
-        {
-        	global_count_of_top_ranked_remaining_candidates = 1 ;
-            point_to_next_ballot_group( ) ;
-        }
+        global_count_of_top_ranked_remaining_candidates = global_count_of_top_ranked_for_ballot_group[ global_ballot_group_pointer ] ;
 
 
 // -----------------------------------------------
@@ -2476,18 +4128,15 @@ void adjust_for_quota_excess( )
 
 // -----------------------------------------------
 //  If there are multiple top-ranked candidates,
-//  but none of them are the just-elected
-//  candidate, repeat the loop.
-//  Reminder:  The true-or-false list was updated
-//  only if there were multiple top-ranked
-//  candidates.
+//  repeat the loop.  Even if the just-elected
+//  candidate is one of them, at least one other
+//  top-ranked candidate is still remaining, so
+//  these ballots still support a remaining
+//  candidate and are not adjusted.
 
         if ( global_count_of_top_ranked_remaining_candidates > 1 )
         {
-            if ( global_true_or_false_is_top_ranked_candidate[ global_candidate_just_elected ] != global_true )
-            {
-                continue ;
-            }
+            continue ;
         }
 
 
@@ -2629,6 +4278,15 @@ void method_rcipe_stv( )
     global_need_to_initialize_group_ballot_count = global_true ;
 
 
+// -----------------------------------------------
+//  Identify the top-ranked candidates in each
+//  ballot group.  After this, only the ballot
+//  groups that top-rank an elected or eliminated
+//  candidate need to be updated.
+
+    initialize_top_ranked_tracking( ) ;
+
+
 // -----------------------------------------------
 //  Begin the loop that handles each counting
 //  cycle.  The loop exits when all the available
@@ -2758,72 +4416,27 @@ void method_rcipe_stv( )
 
 
 // -----------------------------------------------
-//  Begin a loop that handles each group of
-//  identical ballots, one ballot group at a time.
-
-        global_count_of_unique_pattern_numbers = 0 ;
-        global_pointer_to_voteinfo_number = 1 ;
-        for ( global_ballot_group_pointer = 1 ; global_ballot_group_pointer <= global_total_count_of_ballot_groups ; global_ballot_group_pointer ++ )
-        {
-
-
-// -----------------------------------------------
-//  For the current ballot group, identify which
-//  remaining (not-yet-eliminated and
-//  not-yet-elected) candidate is ranked highest.
-//  Allow for two or more candidates to be
-//  highest-ranked.  Also get the ballot count
-//  that indicates how many ballots are in this
-//  ballot group (of identical ballots), and get
-//  this ballot group's remaining vote count.
-
-            global_ballot_info_repeat_count = get_candidate_ranks_from_one_ballot_group( ) ;
-
-
-// -----------------------------------------------
-//  Add this ballot group's remaining vote count
-//  to the sum of all the remaining vote counts.
-
-            global_current_total_vote_count += global_ballot_count_remaining_for_ballot_group[ global_ballot_group_pointer ] ;
-
-
-// -----------------------------------------------
-//  If the end of the ballot groups has been
-//  reached, exit the loop that handles each
-//  ballot group.
-
-            if ( global_ballot_info_repeat_count < 1 )
-            {
-                break ;
-            }
-
-
-// -----------------------------------------------
-//  Add the full-influence (remaining) ballots in
-//  the current ballot group to a counter that
-//  applies to all the ballots that have the same
-//  available (remaining) candidates ranked above
-//  all the other available candidates.
-//
-//  For example, if candidates A and B have been
-//  elected or eliminated, and a ballot group
-//  ranks candidate A highest and ranks candidates
-//  B, C, and D at the next-highest level, and
-//  another ballot group ranks candidate B highest
-//  and ranks candidates A, C, and D at the
-//  next-highest level, then these two ballot
-//  groups are counted together, along with any
-//  other ballot groups that rank candidates C and
-//  D as the highest-ranked remaining candidates.
+//  Update the top-ranked candidates in the ballot
+//  groups that top-rank any candidate who was
+//  elected or eliminated during the previous
+//  counting cycle.
 
-            add_current_ballot_group_votes_to_vote_transfer_counts( ) ;
+        update_top_ranked_tracking( ) ;
 
 
 // -----------------------------------------------
-//  Repeat the loop that gets information from
-//  each ballot group.
+//  Count the full-influence (remaining) ballots
+//  in all the ballot groups.  For each ballot
+//  group, identify which remaining
+//  (not-yet-eliminated and not-yet-elected)
+//  candidate is ranked highest, allowing for two
+//  or more candidates to be highest-ranked, and
+//  add the ballot group's remaining vote count to
+//  the count for that candidate or for that
+//  combination of shared top-ranked candidates.
 
-        }
+        clear_pattern_table( ) ;
+        count_all_ballot_groups( ) ;
 
 
 // -----------------------------------------------
@@ -3340,6 +4953,60 @@ void method_rcipe_stv( )
 }
 
 
+// -----------------------------------------------
+// -----------------------------------------------
+//        write_binary_results
+//
+//  Writes the result code numbers to the standard
+//  output file in the binary voteinfo format.
+//  The numbers are the same as in the text
+//  version, ending with the end-of-all-cases
+//  code.
+
+void write_binary_results( )
+{
+
+    int count_of_result_codes ;
+    int pointer_to_result_code ;
+    int current_result_info_number ;
+
+
+// -----------------------------------------------
+//  Count the result codes, including the
+//  end-of-all-cases code.
+
+    count_of_result_codes = 0 ;
+    while ( ( count_of_result_codes < global_length_of_result_info_list ) && ( count_of_result_codes < global_maximum_output_results_length ) )
+    {
+        count_of_result_codes ++ ;
+        if ( global_output_results[ count_of_result_codes - 1 ] == global_voteinfo_code_for_end_of_all_cases )
+        {
+            break ;
+        }
+    }
+
+
+// -----------------------------------------------
+//  Write the header, then each result code.
+
+    put_binary_voteinfo_header( global_binary_content_type_result_codes , global_case_number , 1 , global_number_of_candidates , count_of_result_codes ) ;
+    for ( pointer_to_result_code = 0 ; pointer_to_result_code < count_of_result_codes ; pointer_to_result_code ++ )
+    {
+        current_result_info_number = global_output_results[ pointer_to_result_code ] ;
+        put_binary_unsigned_number( ( (unsigned int) current_result_info_number << 1 ) ^ (unsigned int) ( current_result_info_number >> 31 ) ) ;
+    }
+    std::cout.flush( ) ;
+    if ( global_logging_info == global_true ) { log_out << std::endl << "[wrote " << count_of_result_codes << " result codes in binary format]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  End of function write_binary_results.
+
+    return ;
+
+}
+
+
 // -----------------------------------------------
 // -----------------------------------------------
 //  Execution starts here.
@@ -3365,6 +5032,13 @@ int main() {
     read_data( ) ;
 
 
+// -----------------------------------------------
+//  Compile the ballots into the ballot-group
+//  table that is used during the counting cycles.
+
+    compile_ballot_group_table( ) ;
+
+
 // -----------------------------------------------
 //  Do the election calculations.
 
@@ -3378,6 +5052,18 @@ int main() {
     put_next_result_info_number( global_voteinfo_code_for_end_of_all_cases ) ;
     global_length_of_result_info_list = global_pointer_to_output_results + 1 ;
     if ( global_logging_info == global_true ) { log_out << std::endl << "[all results, length of output list is " << global_length_of_result_info_list << "]" << std::endl ; } ;
+
+
+// -----------------------------------------------
+//  If requested, write the results in the binary
+//  voteinfo format instead of as text.
+
+    if ( global_true_or_false_request_binary_output == global_true )
+    {
+        write_binary_results( ) ;
+        if ( global_logging_info == global_true ) { log_out << std::endl << "[results written, all done]" << std::endl ; } ;
+        return 0 ;
+    }
     newline_or_space = "" ;
     global_pointer_to_output_results = 0 ;
     current_result_info_number = 0 ;
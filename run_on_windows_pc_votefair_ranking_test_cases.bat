@@ -5,8 +5,12 @@ path=C:\Program Files (x86)\mingw-w64\i686-8.1.0-posix-dwarf-rt_v6-rev0\mingw32\
 set TestCasePath=C:\whatever_path\VoteFair-ranking-cpp\test_cases\
 
 del votefair_ranking.exe
+del convert_voteinfo_text_binary.exe
+del rcipe_stv.exe
 
 g++ votefair_ranking.cpp -o votefair_ranking
+g++ convert_voteinfo_text_binary.cpp -o convert_voteinfo_text_binary
+g++ rcipe_stv.cpp -o rcipe_stv
 
 .\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_101.txt > %TestCasePath%output_votefair_ranking_test_case_101.txt
 copy output_votefair_ranking_log.txt %TestCasePath%output_log_test_case_101.txt
@@ -31,6 +35,23 @@ copy output_votefair_ranking_log.txt %TestCasePath%output_log_test_case_114.txt
 copy output_votefair_ranking_log.txt %TestCasePath%output_log_test_case_117.txt
 .\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_118.txt > %TestCasePath%output_votefair_ranking_test_case_118.txt
 .\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_119.txt > %TestCasePath%output_votefair_ranking_test_case_119.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_120.txt > %TestCasePath%output_votefair_ranking_test_case_120.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_121.txt > %TestCasePath%output_votefair_ranking_test_case_121.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_122.txt > %TestCasePath%output_votefair_ranking_test_case_122.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_123.txt > %TestCasePath%output_votefair_ranking_test_case_123.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_124.txt > %TestCasePath%output_votefair_ranking_test_case_124.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_125.txt > %TestCasePath%output_votefair_ranking_test_case_125.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_126.txt > %TestCasePath%output_votefair_ranking_test_case_126.txt
+.\votefair_ranking < %TestCasePath%input_votefair_ranking_test_case_127.txt | .\convert_voteinfo_text_binary > %TestCasePath%output_votefair_ranking_test_case_127.txt
+.\convert_voteinfo_text_binary < %TestCasePath%input_votefair_ranking_test_case_128.txt | .\votefair_ranking > %TestCasePath%output_votefair_ranking_test_case_128.txt
+.\rcipe_stv < %TestCasePath%input_rcipe_stv_test_case_131.txt > %TestCasePath%output_rcipe_stv_test_case_131.txt
+.\rcipe_stv < %TestCasePath%input_rcipe_stv_test_case_132.txt > %TestCasePath%output_rcipe_stv_test_case_132.txt
+
+rem note: cases 129 and 130 use the server mode, which is only available on
+rem Unix-like systems, so they are not run here.  On those systems they are
+rem run with these commands:
+rem ./votefair_ranking --server - < input_votefair_ranking_test_case_129.txt > output_votefair_ranking_test_case_129.txt
+rem ./votefair_ranking --server - 1 --cache-megabytes 1 < input_votefair_ranking_test_case_130.txt > output_votefair_ranking_test_case_130.txt
 
 type %TestCasePath%output_votefair_ranking_test_case_101.txt > %TestCasePath%combined_output_all_cases.txt
 type %TestCasePath%output_votefair_ranking_test_case_102.txt >> %TestCasePath%combined_output_all_cases.txt
@@ -51,6 +72,17 @@ type %TestCasePath%output_votefair_ranking_test_case_116.txt >> %TestCasePath%co
 type %TestCasePath%output_votefair_ranking_test_case_117.txt >> %TestCasePath%combined_output_all_cases.txt
 type %TestCasePath%output_votefair_ranking_test_case_118.txt >> %TestCasePath%combined_output_all_cases.txt
 type %TestCasePath%output_votefair_ranking_test_case_119.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_120.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_121.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_122.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_123.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_124.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_125.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_126.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_127.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_votefair_ranking_test_case_128.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_rcipe_stv_test_case_131.txt >> %TestCasePath%combined_output_all_cases.txt
+type %TestCasePath%output_rcipe_stv_test_case_132.txt >> %TestCasePath%combined_output_all_cases.txt
 
 type %TestCasePath%answer_expected_for_case_101.txt > %TestCasePath%answers_expected_all_cases.txt
 type %TestCasePath%answer_expected_for_case_102.txt >> %TestCasePath%answers_expected_all_cases.txt
@@ -71,6 +103,17 @@ type %TestCasePath%answer_expected_for_case_116.txt >> %TestCasePath%answers_exp
 type %TestCasePath%answer_expected_for_case_117.txt >> %TestCasePath%answers_expected_all_cases.txt
 type %TestCasePath%answer_expected_for_case_118.txt >> %TestCasePath%answers_expected_all_cases.txt
 type %TestCasePath%answer_expected_for_case_119.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_120.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_121.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_122.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_123.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_124.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_125.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_126.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_127.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_128.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_131.txt >> %TestCasePath%answers_expected_all_cases.txt
+type %TestCasePath%answer_expected_for_case_132.txt >> %TestCasePath%answers_expected_all_cases.txt
 
 rem note: instead of kdiff3 you can use any of the tools listed at:
 rem https://en.wikipedia.org/wiki/Comparison_of_file_comparison_tools
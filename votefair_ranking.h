@@ -0,0 +1,151 @@
+//  votefair_ranking.h
+//
+//  Declares the library interface to the VoteFair
+//  Ranking calculations in votefair_ranking.cpp.
+//  The library interface supplies the ballots and
+//  requests directly, instead of through standard
+//  input, and gets the results directly, instead
+//  of through standard output.  No log file is
+//  written.
+//
+//  Each call to calculate_votefair_ranking uses
+//  its own calculation context, so different
+//  threads can calculate different elections at
+//  the same time.
+//
+//
+// -----------------------------------------------
+//
+//  COPYRIGHT & LICENSE
+//
+//  This file is part of the VoteFairRanking
+//  software, which is (c) Copyright 1991 through
+//  2019 by Richard Fobes at www.VoteFair.org.
+//  You can redistribute and/or modify this
+//  software under the MIT software license terms
+//  that appear in the source-code file
+//  votefair_ranking.cpp.  Also a copy of the
+//  license is included in the LICENSE file.
+//
+//
+// -----------------------------------------------
+//
+//  USAGE
+//
+//  The following sample code compiles
+//  votefair_ranking.cpp as a static library and
+//  as a shared library, instead of as an
+//  application.  Defining VOTEFAIR_RANKING_LIBRARY
+//  omits the "main" code.
+//
+//      g++ -O2 -fPIC -DVOTEFAIR_RANKING_LIBRARY -c votefair_ranking.cpp -o votefair_ranking_library.o
+//
+//      ar rcs libvotefair_ranking.a votefair_ranking_library.o
+//
+//      g++ -shared votefair_ranking_library.o -o libvotefair_ranking.so
+//
+//  Software that uses the library includes this
+//  file and links with either library (plus the
+//  "-pthread" option with some older compilers).
+//
+//
+// -----------------------------------------------
+
+
+#ifndef VOTEFAIR_RANKING_H
+#define VOTEFAIR_RANKING_H
+
+#include <string>
+#include <vector>
+
+
+// -----------------------------------------------
+//  Declare the type that holds one ballot, or a
+//  group of identical ballots.  The choices are
+//  listed from most preferred to least preferred,
+//  and each list within ranked_choices contains
+//  the choices that are ranked at the same level
+//  (usually just one choice).  Choices that are
+//  not listed are ranked below all the listed
+//  choices.  Choice numbers start at 1.
+
+struct votefair_ranking_ballot
+{
+    int ballot_count = 1 ;
+    std::vector< std::vector< int > > ranked_choices ;
+} ;
+
+
+// -----------------------------------------------
+//  Declare the type that holds the ballots for
+//  one question, plus the requests that specify
+//  which results to calculate.  The true-or-false
+//  values use 1 for true and 0 for false.  A
+//  value of zero for a number of levels, threads,
+//  megabytes, or milliseconds means the usual
+//  default value is used.
+
+struct votefair_ranking_request
+{
+    int choice_count = 0 ;
+    std::vector< votefair_ranking_ballot > ballots ;
+    int true_or_false_request_representation_rank = 0 ;
+    int number_of_representation_levels_to_compute = 0 ;
+    int true_or_false_request_party_rank = 0 ;
+    int true_or_false_request_instant_pairwise_elimination = 0 ;
+    int true_or_false_request_pairwise_counts = 1 ;
+    int true_or_false_request_only_plurality_results = 0 ;
+    int number_of_tally_threads = 0 ;
+    int exact_ranking_memory_limit_in_megabytes = 0 ;
+    int exact_ranking_time_limit_in_milliseconds = 0 ;
+} ;
+
+
+// -----------------------------------------------
+//  Declare the type that holds the results.  The
+//  lists that are indexed by choice number have
+//  one more position than the number of choices,
+//  and position zero is not used.  A ranking
+//  level of 1 is the most popular (or most
+//  representative) level, and a ranking level of
+//  zero means that ranking was not calculated.
+//  Each ranking sequence lists the ranking levels
+//  in order, and each level lists the choices at
+//  that level.  The tally at [ first ][ second ]
+//  is the number of ballots that rank the first
+//  choice over the second choice, as a 64-bit
+//  number because the tallies can exceed the
+//  range of "int".  The winner of
+//  Instant Pairwise Elimination is zero if it was
+//  not calculated, and the proven-optimal value
+//  is only supplied when an exact-ranking time
+//  limit is requested.
+
+struct votefair_ranking_result
+{
+    int total_vote_count = 0 ;
+    std::vector< int > plurality_count_for_choice ;
+    std::vector< std::vector< long long > > tally_first_over_second ;
+    std::vector< int > popularity_level_for_choice ;
+    std::vector< std::vector< int > > popularity_sequence ;
+    std::vector< int > representation_level_for_choice ;
+    std::vector< std::vector< int > > representation_sequence ;
+    std::vector< int > party_level_for_choice ;
+    std::vector< std::vector< int > > party_sequence ;
+    int instant_pairwise_elimination_winner = 0 ;
+    int true_or_false_popularity_ranking_proven_optimal = 0 ;
+    std::string error_message ;
+} ;
+
+
+// -----------------------------------------------
+//  Declare the function that calculates the
+//  results.  It returns 1 if the calculations
+//  were done, or 0 if they were not done, in
+//  which case the result contains an error
+//  message.
+
+int calculate_votefair_ranking( const votefair_ranking_request & request , votefair_ranking_result & result ) ;
+
+
+#endif